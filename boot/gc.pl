@@ -53,13 +53,20 @@ gc_loop :-
     (   Action == abort
     ->  true
     ;   process(Action)
-    ->  '$gc_clear'(Action),
-        fail
+    ->  fail
     ;   print_message(warning, gc(ignored(Action))),
         fail
     ).
 
+%!  process(+Action) is semidet.
+%
+%   Process a GC request.  Clause GC is performed in time limited slices
+%   (see the flag `cgc_max_pause`).  We clear the request before running
+%   the slice, such that an incomplete slice can schedule the next one.
+
 process(garbage_collect_atoms) :-
-    garbage_collect_atoms.
+    garbage_collect_atoms,
+    '$gc_clear'(garbage_collect_atoms).
 process(garbage_collect_clauses) :-
-    garbage_collect_clauses.
+    '$gc_clear'(garbage_collect_clauses),
+    '$cgc_slice'.
@@ -94,6 +94,7 @@
 :- meta_predicate
     dynamic(:, +),
     transaction(0),
+    transaction(0,+),
     transaction(0,0,+),
     snapshot(0),
     rule(:, -),
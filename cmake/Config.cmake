@@ -159,6 +159,7 @@ alignof(ALIGNOF_INT64_T ALIGNOF_VOIDP ALIGNOF_DOUBLE)
 # Misc
 if(NOT EMSCRIPTEN)
   check_function_exists(mmap HAVE_MMAP)
+  check_function_exists(mremap HAVE_MREMAP)
   check_function_exists(popen HAVE_POPEN)
 endif()
 check_function_exists(strerror HAVE_STRERROR)
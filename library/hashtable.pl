@@ -151,8 +151,8 @@ ht_put(HT, Key, Value, IfNew, Old, IsNew) :-
     ->  ht_resize(HT),
         ht_put(HT, Key, Value, IfNew, Old, IsNew)
     ;   variant_hash(Key, I0),
-        I is I0 mod Size,
-        put_(Buckets, I, Size, Key, Old, IfNew, Value, IsNew),
+        '$ht_probe'(Key, I0, HT, I),
+        put_(Buckets, I, Key, Old, IfNew, Value, IsNew),
         (   IsNew == true
         ->  Load2 is Load+1,
             setarg(1, HT, Load2)
@@ -160,19 +160,21 @@ ht_put(HT, Key, Value, IfNew, Old, IsNew) :-
         )
     ).
 
-put_(Buckets, I, Size, Key, Old, IfNew, Value, IsNew) :-
+%   put_(+Buckets, +I, +Key, -Old, +IfNew, +Value, -IsNew)
+%
+%   Store Value in slot I, as found by '$ht_probe'/4.  The slot either
+%   holds Key or is free.
+
+put_(Buckets, I, Key, Old, IfNew, Value, IsNew) :-
     ht_kv(Buckets, I, K, V),
     (   var(K)
     ->  IsNew = true,
         Old = IfNew,
         K = Key,
         V = Value
-    ;   K == Key
-    ->  IsNew = false,
+    ;   IsNew = false,
         Old = V,
         ht_put_v(Buckets, I, Value)
-    ;   I2 is (I+1) mod Size,
-        put_(Buckets, I2, Size, Key, Old, IfNew, Value, IsNew)
     ).
 
 ht_resize(HT) :-
@@ -218,22 +220,17 @@ ht_del(HT, Key, Value) :-
     HT = ht(Load, Size, Buckets),
     Load > 0,
     variant_hash(Key, I0),
-    I is I0 mod Size,
-    del_(Buckets, I, Size, Key, Value),
+    '$ht_probe'(Key, I0, HT, I),
+    del_(Buckets, I, Size, Value),
     Load2 is Load - 1,
     setarg(1, HT, Load2).
 
-del_(Buckets, I, Size, Key, Value) :-
+del_(Buckets, I, Size, Value) :-
     ht_kv(Buckets, I, K, V),
-    (   var(K)
-    ->  fail
-    ;   K == Key
-    ->  V = Value,
-        ht_put_kv(Buckets, I, _, _),
-        del_shift(Buckets, I, I, Size)
-    ;   I2 is (I+1) mod Size,
-        del_(Buckets, I2, Size, Key, Value)
-    ).
+    nonvar(K),
+    V = Value,
+    ht_put_kv(Buckets, I, _, _),
+    del_shift(Buckets, I, I, Size).
 
 del_shift(Buckets, I0, J, Size) :-
     I is (I0+1) mod Size,
@@ -258,21 +255,15 @@ del_shift(Buckets, I0, J, Size) :-
 %
 %   True when Key is in HT and associated with Value.
 
-ht_get(ht(Load, Size, Buckets), Key, Value) :-
+ht_get(HT, Key, Value) :-
+    HT = ht(Load, _Size, Buckets),
     Load > 0,
     must_be(nonvar, Key),
     variant_hash(Key, I0),
-    I is I0 mod Size,
-    get_(Buckets, I, Size, Key, Value).
-
-get_(Buckets, I, Size, Key, Value) :-
+    '$ht_probe'(Key, I0, HT, I),
     ht_kv(Buckets, I, K, V),
-    (   Key == K
-    ->  Value = V
-    ;   nonvar(K)
-    ->  I2 is (I+1) mod Size,
-        get_(Buckets, I2, Size, Key, Value)
-    ).
+    nonvar(K),
+    Value = V.
 
 ht_k(Buckets, I, K) :-
     IK is I*2+1,
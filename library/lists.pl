@@ -663,6 +663,10 @@ min_member_([H|T], Pred, Min0, Min) =>
 %
 %   Sum is the result of adding all numbers in List.
 
+sum_list(Xs, Sum) :-
+    '$sum_list'(Xs, Sum0),
+    !,
+    Sum = Sum0.
 sum_list(Xs, Sum) :-
     sum_list(Xs, 0, Sum).
 
@@ -679,6 +683,8 @@ sum_list([X|Xs], Sum0, Sum) =>
 %
 %   @see max_member/2.
 
+max_list(Xs, Max), '$max_list'(Xs, Max0) =>
+    Max = Max0.
 max_list([H|T], Max) =>
     max_list(T, H, Max).
 max_list([], _) => fail.
@@ -697,6 +703,8 @@ max_list([H|T], Max0, Max) =>
 %
 %   @see min_member/2.
 
+min_list(Xs, Min), '$min_list'(Xs, Min0) =>
+    Min = Min0.
 min_list([H|T], Min) =>
     min_list(T, H, Min).
 min_list([], _) => fail.
@@ -719,7 +727,11 @@ numlist(L, U, Ns) :-
     must_be(integer, L),
     must_be(integer, U),
     L =< U,
-    numlist_(L, U, Ns).
+    (   var(Ns),                        % avoid building a huge list
+        '$numlist'(L, U, Ns0)           % that cannot unify
+    ->  Ns = Ns0
+    ;   numlist_(L, U, Ns)
+    ).
 
 numlist_(U, U, List) :-
     !,
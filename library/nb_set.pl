@@ -89,38 +89,20 @@ empty_nb_set(NbSet) :-
 add_nb_set(Key, Set) :-
     add_nb_set(Key, Set, _).
 add_nb_set(Key, Set, New) :-
-    Set = nb_set(Empty, Capacity, Size, Buckets),
+    Set = nb_set(_Empty, Capacity, Size, Buckets),
     key_hash(Key, Hash),
-    index(Hash, Capacity, KIndex),
-        arg(KIndex, Buckets, StoredKey),
-        (   same_term(StoredKey, Empty)
-        ->  !,
-            New = true,
-            nb_setarg(KIndex, Buckets, Key),
-            NSize is Size+1,
-            nb_setarg(3, Set, NSize),
-            (   NSize > Capacity//2
-            ->  rehash(Set)
-            ;   true
-            )
-        ;   Key =@= StoredKey
-        ->  !,
-            New = false
-        ).
-
-%!  index(+Hash, +Capacity, -Index) is nondet.
-%
-%   Generate  candidate  values  for  Index,  starting  from  `Hash  mod
-%   Capacity`, round tripping to 1 when Capacity is reached.
-
-index(Hash, Capacity, KIndex) :-
-    KIndex0 is (Hash mod Capacity) + 1,
-    next(KIndex0, Capacity, KIndex).
-
-next(KIndex, _, KIndex).
-next(KIndex0, Capacity, KIndex) :-
-    KIndex1 is 1+(KIndex0 mod Capacity),
-    next(KIndex1, Capacity, KIndex).
+    '$nb_set_probe'(Key, Hash, Set, KIndex),
+    (   KIndex =:= 0
+    ->  New = false
+    ;   New = true,
+        nb_setarg(KIndex, Buckets, Key),
+        NSize is Size+1,
+        nb_setarg(3, Set, NSize),
+        (   NSize > Capacity//2
+        ->  rehash(Set)
+        ;   true
+        )
+    ).
 
 rehash(Set) :-
     Set = nb_set(Empty, Capacity, Size, Buckets),
@@ -41,8 +41,11 @@
             thread_statistics/2,        % ?Thread, -Stats
             time/1,                     % :Goal
             call_time/2,                % :Goal, -Time
-            call_time/3                 % :Goal, -Time, -Result
+            call_time/3,                % :Goal, -Time, -Result
+            latency_metrics/1,          % -Metrics
+            print_latency_metrics/1     % +Stream
           ]).
+:- autoload(library(apply),[foldl/4,exclude/3]).
 :- autoload(library(pairs),[map_list_to_pairs/3]).
 
 :- set_prolog_flag(generate_debug_info, false).
@@ -385,6 +388,63 @@ time_true(State) :-
     fail.
 
 
+                 /*******************************
+                 *        LATENCY METRICS       *
+                 *******************************/
+
+%!  latency_metrics(-Metrics:dict) is det.
+%
+%   Snapshot of the process-wide latency histograms. Metrics is a dict
+%   with keys `gc_pause`, `agc_pause`, `cgc_pause`, `index_build`,
+%   `queue_wait` and `table_completion`. Each value is a dict
+%
+%       histogram{count:Count, sum:Sum, max:Max, buckets:Buckets}
+%
+%   where Sum and Max are in seconds and Buckets is a list
+%   `UpperBound-Count` of the non-empty buckets in ascending order.
+%   The buckets have a relative precision of 12.5%.
+
+latency_metrics(Metrics) :-
+    '$metrics'(List),
+    findall(Name-histogram{count:Count, sum:Sum, max:Max, buckets:Buckets},
+            ( member(Name-histogram(Count, Sum, Max, AllBuckets), List),
+              exclude(empty_bucket, AllBuckets, Buckets)
+            ),
+            Pairs),
+    dict_pairs(Metrics, metrics, Pairs).
+
+empty_bucket(_-0).
+
+%!  print_latency_metrics(+Out:stream) is det.
+%
+%   Print the latency histograms to Out  in the Prometheus text format.
+%   For each histogram Name, this emits  the cumulative buckets as
+%   `swipl_Name_seconds_bucket`, `swipl_Name_seconds_sum`,
+%   `swipl_Name_seconds_count` and the largest observation as the
+%   gauge `swipl_Name_seconds_max`.  Empty buckets below the highest
+%   non-empty one are printed as well, so the `le` labels of a
+%   histogram do not change while its range stays the same.
+
+print_latency_metrics(Out) :-
+    '$metrics'(List),
+    forall(member(Name-histogram(Count, Sum, Max, Buckets), List),
+           print_histogram(Out, Name, Count, Sum, Max, Buckets)).
+
+print_histogram(Out, Name, Count, Sum, Max, Buckets) :-
+    format(Out, '# TYPE swipl_~w_seconds histogram~n', [Name]),
+    foldl(print_bucket(Out, Name), Buckets, 0, Total),
+    All is max(Count, Total),           % snapshot is not atomic
+    format(Out, 'swipl_~w_seconds_bucket{le="+Inf"} ~d~n', [Name, All]),
+    format(Out, 'swipl_~w_seconds_sum ~w~n', [Name, Sum]),
+    format(Out, 'swipl_~w_seconds_count ~d~n', [Name, All]),
+    format(Out, '# TYPE swipl_~w_seconds_max gauge~n', [Name]),
+    format(Out, 'swipl_~w_seconds_max ~w~n', [Name, Max]).
+
+print_bucket(Out, Name, Le-N, Acc0, Acc) :-
+    Acc is Acc0+N,
+    format(Out, 'swipl_~w_seconds_bucket{le="~w"} ~d~n', [Name, Le, Acc]).
+
+
                  /*******************************
                  *            MESSAGES          *
                  *******************************/
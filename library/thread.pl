@@ -44,14 +44,22 @@
             concurrent_forall/3,        % :Generate, :Test, +Options
             concurrent_and/2,           % :Generator,:Test
             concurrent_and/3,           % :Generator,:Test,+Options
+            concurrent_findall/3,       % +Template, :Goal, -Bag
+            concurrent_findall/4,       % +Template, :Goal, -Bag, +Options
+            concurrent_aggregate_all/3, % +Spec, :Goal, -Result
+            concurrent_aggregate_all/4, % +Spec, :Goal, -Result, +Options
             first_solution/3,           % -Var, :Goals, +Options
 
             call_in_thread/2,           % +Thread, :Goal
             call_in_thread/3            % +Thread, :Goal, +Options
           ]).
+:- autoload(library(aggregate), [aggregate_all/3]).
 :- autoload(library(apply), [maplist/2, maplist/3, maplist/4, maplist/5]).
 :- autoload(library(error), [must_be/2, instantiation_error/1]).
-:- autoload(library(lists), [subtract/3, same_length/2, nth0/3]).
+:- autoload(library(lists),
+            [ subtract/3, same_length/2, nth0/3, append/2, sum_list/2,
+              max_list/2, min_list/2
+            ]).
 :- autoload(library(option), [option/2, option/3, meta_options/3]).
 :- autoload(library(ordsets), [ord_intersection/3, ord_union/3]).
 :- use_module(library(debug), [debug/3, assertion/1]).
@@ -67,6 +75,10 @@
     concurrent_forall(0, 0, +),
     concurrent_and(0, 0),
     concurrent_and(0, 0, +),
+    concurrent_findall(?, 0, -),
+    concurrent_findall(?, 0, -, +),
+    concurrent_aggregate_all(?, 0, -),
+    concurrent_aggregate_all(?, 0, -, +),
     first_solution(-, :, +),
     call_in_thread(+, 0),
     call_in_thread(+, 0, :).
@@ -81,6 +93,12 @@
 :- predicate_options(concurrent_and/3, 3,
                      [ threads(nonneg)
                      ]).
+:- predicate_options(concurrent_findall/4, 4,
+                     [ threads(nonneg)
+                     ]).
+:- predicate_options(concurrent_aggregate_all/4, 4,
+                     [ threads(nonneg)
+                     ]).
 :- predicate_options(first_solution/3, 3,
                      [ on_fail(oneof([stop,continue])),
                        on_error(oneof([stop,continue])),
@@ -542,6 +560,195 @@ ca_cleanup(GenThread, Workers, JobQueue, AnswerQueue) :-
     catch(message_queue_destroy(JobQueue), error(_,_), true).
 
 
+		 /*******************************
+		 *      FINDALL/AGGREGATE	*
+		 *******************************/
+
+%!  concurrent_findall(+Template, :Goal, -Bag) is det.
+%!  concurrent_findall(+Template, :Goal, -Bag, +Options) is det.
+%
+%   Concurrent version of findall/3. If  the   first  subgoal  of Goal
+%   calls a predicate that is defined  by   clauses,  the clauses of this
+%   predicate are split into consecutive ranges that are each handled by
+%   a thread.  Each thread runs the remainder  of Goal for the clauses in
+%   its range and the results are  concatenated   in  clause order. Bag
+%   is therefore the same as for findall/3 if   Goal is free of (shared)
+%   side effects.  Options:
+%
+%     - threads(+Count)
+%       Number of threads to use.  The default is determined by the
+%       Prolog flag `cpu_count`.
+%
+%   Goal is evaluated using findall/3 if the first subgoal is a control
+%   structure, a foreign or undefined predicate,  if the predicate has
+%   a clause that uses cut (!) or if there is only one thread.  For
+%   dynamic predicates, each thread uses its own logical update view.
+
+concurrent_findall(Templ, Goal, Bag) :-
+    concurrent_findall(Templ, Goal, Bag, []).
+
+concurrent_findall(Templ, Goal, Bag, Options) :-
+    jobs(Jobs, Options),
+    Jobs > 1,
+    partition_goal(Goal, Jobs, Parts),
+    !,
+    maplist(findall_part(Templ), Parts, Bags, Goals),
+    length(Parts, Threads),
+    concurrent(Threads, Goals, []),
+    append(Bags, Bag).
+concurrent_findall(Templ, Goal, Bag, _) :-
+    findall(Templ, Goal, Bag).
+
+findall_part(Templ, Part, Bag, findall(Templ, Part, Bag)).
+
+%!  concurrent_aggregate_all(+Spec, :Goal, -Result) is semidet.
+%!  concurrent_aggregate_all(+Spec, :Goal, -Result, +Options) is semidet.
+%
+%   Concurrent version of aggregate_all/3 that   splits  Goal the same
+%   way as concurrent_findall/4, computes an   aggregate for each part
+%   and merges the results.  Spec is one of  `count`, sum(Expr),
+%   max(Expr), min(Expr), bag(Template)  or   set(Template).  Other
+%   aggregation specifications are evaluated   by aggregate_all/3.  As
+%   with aggregate_all/3, max(Expr) and min(Expr)   fail if Goal has no
+%   solutions.  Note that sum(Expr) adds  the   sums  of the parts, which
+%   may round differently if Expr evaluates to floats.
+
+concurrent_aggregate_all(Spec, Goal, Result) :-
+    concurrent_aggregate_all(Spec, Goal, Result, []).
+
+concurrent_aggregate_all(Spec, Goal, Result, Options) :-
+    must_be(nonvar, Spec),
+    aggregate_parts(Spec, _, _, _),
+    jobs(Jobs, Options),
+    Jobs > 1,
+    partition_goal(Goal, Jobs, Parts),
+    !,
+    maplist(aggregate_part(Spec), Parts, Partials, Goals),
+    length(Parts, Threads),
+    concurrent(Threads, Goals, []),
+    aggregate_parts(Spec, Partials, Result, _).
+concurrent_aggregate_all(Spec, Goal, Result, _) :-
+    aggregate_all(Spec, Goal, Result).
+
+aggregate_part(Spec, Part, Partial, Goal) :-
+    aggregate_parts(Spec, _, _, part(Part, Partial, Goal)).
+
+%!  aggregate_parts(+Spec, +Partials, -Result, ?PartGoal)
+%
+%   Describes how Spec is computed  for  a   single  part  and  how the
+%   partial results are combined.  PartGoal is   a term part(Part,
+%   Partial, Goal), where Goal computes Partial for Part.
+
+aggregate_parts(count, Partials, Count, part(Part, N, aggregate_all(count, Part, N))) :-
+    sum_parts(Partials, Count).
+aggregate_parts(sum(X), Partials, Sum, part(Part, S, aggregate_all(sum(X), Part, S))) :-
+    sum_parts(Partials, Sum).
+aggregate_parts(max(X), Partials, Max, part(Part, L, findall(M, aggregate_all(max(X), Part, M), L))) :-
+    (   var(Partials)
+    ->  true
+    ;   append(Partials, List),
+        max_list(List, Max)
+    ).
+aggregate_parts(min(X), Partials, Min, part(Part, L, findall(M, aggregate_all(min(X), Part, M), L))) :-
+    (   var(Partials)
+    ->  true
+    ;   append(Partials, List),
+        min_list(List, Min)
+    ).
+aggregate_parts(bag(X), Partials, Bag, part(Part, L, findall(X, Part, L))) :-
+    (   var(Partials)
+    ->  true
+    ;   append(Partials, Bag)
+    ).
+aggregate_parts(set(X), Partials, Set, part(Part, L, findall(X, Part, L))) :-
+    (   var(Partials)
+    ->  true
+    ;   append(Partials, Bag),
+        sort(Bag, Set)
+    ).
+
+sum_parts(Partials, _) :-
+    var(Partials),
+    !.
+sum_parts(Partials, Sum) :-
+    sum_list(Partials, Sum).
+
+%!  partition_goal(:Goal, +Jobs, -Parts) is semidet.
+%
+%   Split Goal into at most Jobs goals Parts, such that the solutions of
+%   Goal are the solutions of Parts  in   order.  Fails if Goal cannot be
+%   partitioned over the clauses of its first subgoal.  Tabled and
+%   wrapped predicates are not partitioned because running their
+%   clause bodies directly bypasses the table or wrapper.  Neither
+%   are SSU (`=>`) predicates because the clauses of a part do not
+%   see the commit of a matching clause in another part.
+
+partition_goal(M:Goal, Jobs, Parts) :-
+    first_subgoal(Goal, First, Rest),
+    callable(First),
+    strip_module(M:First, FM, Head),
+    \+ predicate_property(FM:Head, built_in),
+    \+ predicate_property(FM:Head, foreign),
+    \+ predicate_property(FM:Head, tabled),
+    \+ predicate_property(FM:Head, wrapped(_)),
+    \+ predicate_property(FM:Head, ssu),
+    predicate_property(FM:Head, number_of_clauses(Count)),
+    Count > 1,
+    predicate_property(FM:Head, implementation_module(CM)),
+    \+ has_cut_clause(CM:Head),
+    findall(Ref, nth_clause(FM:Head, _, Ref), Refs),
+    length(Refs, Len),
+    Chunks is min(Jobs, Len),
+    split_list(Chunks, Len, Refs, RefLists),
+    maplist(part_goal(Head, CM, M:Rest), RefLists, Parts).
+
+first_subgoal((A,B), First, Rest) :-
+    !,
+    first_subgoal(A, First, Rest0),
+    (   Rest0 == true
+    ->  Rest = B
+    ;   Rest = (Rest0,B)
+    ).
+first_subgoal(Goal, Goal, true).
+
+has_cut_clause(Head) :-
+    predicate_property(Head, number_of_rules(0)),
+    !,
+    fail.
+has_cut_clause(Head) :-
+    clause(Head, Body),
+    has_cut(Body),
+    !.
+
+has_cut(Var) :-
+    var(Var),
+    !,
+    fail.
+has_cut(!).
+has_cut((A,B))  :- ( has_cut(A) ; has_cut(B) ).
+has_cut((A;B))  :- ( has_cut(A) ; has_cut(B) ).
+has_cut((A->B)) :- ( has_cut(A) ; has_cut(B) ).
+has_cut((A*->B)) :- ( has_cut(A) ; has_cut(B) ).
+
+split_list(1, _, List, [List]) :-
+    !.
+split_list(Chunks, Len, List, [Chunk|Rest]) :-
+    Size is Len // Chunks,
+    length(Chunk, Size),
+    append(Chunk, List1, List),
+    Chunks1 is Chunks - 1,
+    Len1 is Len - Size,
+    split_list(Chunks1, Len1, List1, Rest).
+
+part_goal(Head, CM, Rest, Refs, thread:clause_range(Head, CM, Refs, Rest)).
+
+clause_range(Head, CM, Refs, Rest) :-
+    member(Ref, Refs),
+    clause(Head, Body, Ref),
+    call(CM:Body),
+    call(Rest).
+
+
                  /*******************************
                  *             MAPLIST          *
                  *******************************/
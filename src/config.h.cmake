@@ -109,6 +109,7 @@
 #cmakedefine HAVE_MEMORY_H @HAVE_MEMORY_H@
 #cmakedefine HAVE_MMAP @HAVE_MMAP@
 #cmakedefine HAVE_MP_BITCNT_T @HAVE_MP_BITCNT_T@
+#cmakedefine HAVE_MREMAP @HAVE_MREMAP@
 #cmakedefine HAVE_MTRACE @HAVE_MTRACE@
 #cmakedefine HAVE_NANOSLEEP @HAVE_NANOSLEEP@
 #cmakedefine HAVE_NCURSES_CURSES_H @HAVE_NCURSES_CURSES_H@
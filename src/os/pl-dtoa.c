@@ -34,6 +34,8 @@
 
 #include "pl-incl.h"
 #include "pl-dtoa.h"
+#include <float.h>
+#include <fenv.h>
 
 #ifdef WORDS_BIGENDIAN
 #define IEEE_MC68k 1
@@ -79,3 +81,152 @@ FREE_DTOA_LOCK(int n)
 #endif /*MULTIPLE_THREADS*/
 
 #include "dtoa.c"
+
+
+		 /*******************************
+		 *	    FAST PATHS		*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+The conversions below handle the common case of floats that have at most
+15 significant decimal digits and a small decimal exponent without the
+bignum machinery of dtoa.c. If M < 10^15 and 0 <= K <= 22, both M and
+10^K are exact doubles. M/10^K and M*10^K are then correctly rounded by
+a single IEEE operation (Clinger's fast path). Such a decimal is also the
+only one with at most 15 digits that rounds to its double, so it is
+exactly what dtoa() mode 0 would produce. This reasoning requires the
+FPU to round to nearest, so the fast paths are disabled if the Prolog
+flag float_rounding selects another mode. Both functions return false
+for anything else, and the caller falls back to dtoa.c.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define FAST_MAX_MANTISSA 1000000000000000.0	/* 10^15 */
+
+static const double fast_pow10[] =
+{ 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define FAST_FLOAT 1			/* no double rounding (x87) */
+#endif
+
+bool
+fast_strtod(const char *s, const char *e, double *dp)
+{ uint64_t m = 0;
+  int digits = 0;
+  int exp = 0;
+  bool neg = false;
+
+#ifndef FAST_FLOAT
+  return false;
+#endif
+  if ( fegetround() != FE_TONEAREST )	/* see float_rounding flag */
+    return false;
+
+  if ( *s == '-' )
+  { neg = true;
+    s++;
+  } else if ( *s == '+' )
+    s++;
+
+  for(; s < e && *s >= '0' && *s <= '9'; s++)
+  { if ( (m || *s != '0') && ++digits > 15 )
+      return false;
+    m = m*10 + (*s-'0');
+  }
+  if ( s < e && *s == '.' )
+  { for(s++; s < e && *s >= '0' && *s <= '9'; s++)
+    { if ( (m || *s != '0') && ++digits > 15 )
+	return false;
+      m = m*10 + (*s-'0');
+      exp--;
+    }
+  }
+  if ( s < e && (*s == 'e' || *s == 'E') )
+  { int x = 0;
+    bool xneg = false;
+
+    s++;
+    if ( s < e && (*s == '-' || *s == '+') )
+      xneg = (*s++ == '-');
+    if ( s == e )
+      return false;
+    for(; s < e && *s >= '0' && *s <= '9'; s++)
+    { if ( (x = x*10 + (*s-'0')) > 1000 )
+	return false;
+    }
+    exp += xneg ? -x : x;
+  }
+  if ( s != e )
+    return false;
+
+  double d = (double)m;
+
+  if ( exp < 0 )
+  { if ( exp < -22 )
+      return false;
+    d /= fast_pow10[-exp];
+  } else if ( exp > 0 )
+  { if ( exp > 22 )
+      return false;
+    d *= fast_pow10[exp];
+  }
+
+  *dp = neg ? -d : d;
+  return true;
+}
+
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+fast_dtoa() is the inverse: find the smallest K for which round(|d|*10^K)
+reads back as |d|. Its digits are then the shortest representation. The
+buffer must hold at least 16 characters. On success, the digits (without
+trailing zeros) are in buf, *end points at the end and *decpt and *sign
+are as for dtoa().
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+bool
+fast_dtoa(double d, char *buf, int *decpt, int *sign, char **end)
+{ double a = fabs(d);
+
+#ifndef FAST_FLOAT
+  return false;
+#endif
+  if ( fegetround() != FE_TONEAREST )
+    return false;
+  if ( !(a >= 1e-7 && a < FAST_MAX_MANTISSA) )
+    return false;
+
+  for(int k=0; k <= 22; k++)
+  { double x = a*fast_pow10[k];
+    double m;
+
+    if ( x >= FAST_MAX_MANTISSA )
+      return false;
+    m = floor(x+0.5);
+    if ( m/fast_pow10[k] == a )
+    { uint64_t i = (uint64_t)m;
+      char tmp[20];
+      char *t = tmp+sizeof(tmp);
+      int nd;
+
+      while(i % 10 == 0)		/* m > 0 as a >= 1e-7 */
+      { i /= 10;
+	k--;
+      }
+      do
+      { *--t = (char)('0' + i%10);
+	i /= 10;
+      } while(i);
+      nd = (int)(tmp+sizeof(tmp)-t);
+      memcpy(buf, t, nd);
+      *end   = buf+nd;
+      *decpt = nd-k;
+      *sign  = signbit(d) ? 1 : 0;
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -45,5 +45,8 @@ COMMON(char *)	dtoa(double dd, int mode, int ndigits,
 		     int *decpt, int *sign, char **rve);
 COMMON(void)	freedtoa(char *s);
 double		strtod(const char *in, char **end);
+bool		fast_strtod(const char *s, const char *e, double *dp);
+bool		fast_dtoa(double d, char *buf, int *decpt, int *sign,
+			  char **end);
 
 #endif /*PL_DTOA_H_INCLUDED*/
@@ -1260,6 +1260,14 @@ set_prolog_flag_unlocked(DECL_LD Module m, atom_t k, term_t value,
 
       if ( !PL_get_float_ex(value, &d) )
 	return false;
+#ifdef O_CLAUSEGC
+      if ( k == ATOM_cgc_max_pause )
+      { if ( d < 0.0 )
+	  return PL_error(NULL, 0, NULL, ERR_DOMAIN,
+			  ATOM_not_less_than_zero, value),NULL;
+	GD->clauses.cgc_max_pause = d;
+      }
+#endif
       f->value.f = d;
       break;
     }
@@ -1946,6 +1954,9 @@ initPrologFlags(void)
 #ifdef O_ATOMGC
   setPrologFlag("agc_margin", FT_INTEGER, (intptr_t)GD->atoms.margin);
   setPrologFlag("agc_close_streams", FT_BOOL, false, PLFLAG_AGC_CLOSE_STREAMS);
+#endif
+#ifdef O_CLAUSEGC
+  setPrologFlag("cgc_max_pause", FT_FLOAT, GD->clauses.cgc_max_pause);
 #endif
   setPrologFlag("table_space", FT_INTEGER, (intptr_t)GD->options.tableSpace);
 #ifdef O_PLMT
@@ -35,6 +35,7 @@
     POSSIBILITY OF SUCH DAMAGE.
 */
 
+#define _GNU_SOURCE 1			/* get mremap() */
 #define EMIT_ALLOC_INLINES 1
 #include "pl-incl.h"
 #include "os/pl-cstack.h"
@@ -67,6 +68,9 @@
 #define MAP_ANONYMOUS 0
 #endif
 #endif
+#if defined(HAVE_MREMAP) && defined(MREMAP_MAYMOVE)
+#define O_MREMAP 1
+#endif
 #endif
 
 #undef LD
@@ -217,6 +221,150 @@ freeHeap(void *mem, size_t n)
 #endif /*PL_ALLOC_DONE*/
 
 
+		 /*******************************
+		 *	 SMALL OBJECT CACHE	*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+allocCachedHeap() and freeCachedHeap() are used for small objects that
+are created and destroyed at a high rate, notably clause references.
+Freed objects are kept on a per-thread free list for their size class,
+so assert/retract cycles recycle them without calling malloc() and
+without contention on the malloc arenas.
+
+Objects are often freed by a different thread than the one that created
+them, e.g., by the thread that runs clause garbage collection. When the
+local list of the freeing thread is full (HEAP_CACHE_MAX), the object is
+pushed onto a lock-free list in GD that is shared by all threads. A
+thread whose local list is empty grabs the whole shared list. Beyond
+HEAP_CACHE_SHARED_MAX shared objects we return memory to malloc().
+freeHeapCache() empties the local list when the thread terminates and
+cleanupHeapCache() empties the shared lists on PL_cleanup().
+
+Objects are allocated at the rounded-up size of their class, so a cached
+object is valid for any size that maps to the same class.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define heap_cache_class(n) ((int)(((n)+sizeof(void*)-1)/sizeof(void*))-1)
+#define heap_cache_size(c)  (((size_t)(c)+1)*sizeof(void*))
+
+#define grab_shared_heap_cache(c) LDFUNC(grab_shared_heap_cache, c)
+
+static void *
+grab_shared_heap_cache(DECL_LD int c)
+{ void *mem;
+
+  do
+  { if ( !(mem = GD->heap_cache.classes[c].free) )
+      return NULL;
+  } while(!COMPARE_AND_SWAP_PTR(&GD->heap_cache.classes[c].free, mem, NULL));
+
+  unsigned int count = 0;
+  for(void *p = *(void**)mem; p; p = *(void**)p)
+    count++;
+  ATOMIC_SUB(&GD->heap_cache.classes[c].count, count+1);
+  LD->heap_cache.classes[c].free  = *(void**)mem;
+  LD->heap_cache.classes[c].count = count;
+
+  return mem;
+}
+
+
+void *
+allocCachedHeap(size_t n)
+{ GET_LD
+  int c = heap_cache_class(n);
+
+  if ( c < HEAP_CACHE_CLASSES )
+  { if ( LD )
+    { void *mem;
+
+      if ( (mem=LD->heap_cache.classes[c].free) )
+      { LD->heap_cache.classes[c].free = *(void**)mem;
+	LD->heap_cache.classes[c].count--;
+	LD->heap_cache.hits++;
+	return mem;
+      }
+      if ( (mem=grab_shared_heap_cache(c)) )
+      { LD->heap_cache.hits++;
+	return mem;
+      }
+      LD->heap_cache.misses++;
+    }
+
+    return allocHeapOrHalt(heap_cache_size(c));
+  }
+
+  return allocHeapOrHalt(n);
+}
+
+
+void
+freeCachedHeap(void *mem, size_t n)
+{ GET_LD
+  int c = heap_cache_class(n);
+
+  if ( c < HEAP_CACHE_CLASSES )
+  { if ( LD && LD->magic == LD_MAGIC &&
+	 LD->heap_cache.classes[c].count < HEAP_CACHE_MAX )
+    { *(void**)mem = LD->heap_cache.classes[c].free;
+      LD->heap_cache.classes[c].free = mem;
+      LD->heap_cache.classes[c].count++;
+      return;
+    }
+    if ( GD->heap_cache.classes[c].count < HEAP_CACHE_SHARED_MAX &&
+	 GD->halt.cleaning == CLN_NORMAL )
+    { void *o;
+
+      ATOMIC_INC(&GD->heap_cache.classes[c].count);
+      do
+      { o = GD->heap_cache.classes[c].free;
+	*(void**)mem = o;
+      } while(!COMPARE_AND_SWAP_PTR(&GD->heap_cache.classes[c].free, o, mem));
+      return;
+    }
+
+    freeHeap(mem, heap_cache_size(c));
+  } else
+  { freeHeap(mem, n);
+  }
+}
+
+
+void
+freeHeapCache(PL_local_data_t *ld)
+{ for(int c=0; c<HEAP_CACHE_CLASSES; c++)
+  { void *mem, *next;
+
+    for(mem=ld->heap_cache.classes[c].free; mem; mem=next)
+    { next = *(void**)mem;
+      freeHeap(mem, heap_cache_size(c));
+    }
+    ld->heap_cache.classes[c].free = NULL;
+    ld->heap_cache.classes[c].count = 0;
+  }
+}
+
+
+/* Empty the shared lists.  Called from PL_cleanup(), after which
+   freeCachedHeap() no longer adds to these lists.
+*/
+
+void
+cleanupHeapCache(void)
+{ for(int c=0; c<HEAP_CACHE_CLASSES; c++)
+  { void *mem, *next;
+
+    for(mem=GD->heap_cache.classes[c].free; mem; mem=next)
+    { next = *(void**)mem;
+      freeHeap(mem, heap_cache_size(c));
+    }
+    GD->heap_cache.classes[c].free = NULL;
+    GD->heap_cache.classes[c].count = 0;
+  }
+}
+
+
 		 /*******************************
 		 *	 LINGERING OBJECTS	*
 		 *******************************/
@@ -1384,6 +1532,13 @@ tmp_malloc(size_t req)
   return NULL;
 }
 
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+tmp_realloc() is used by grow_stacks() to resize the Prolog stacks. If
+mremap() is provided, growing an mmapped region either extends it in
+place or lets the kernel move the page tables, so we never copy the
+stack contents. If the region grows in place, the base does not change
+and update_stacks() has no pointers to relocate for it.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 void *
 tmp_realloc(void *mem, size_t req)
@@ -1424,7 +1579,21 @@ tmp_realloc(void *mem, size_t req)
 
 	  return reg->data;
 	} else
-	{ void *ra = tmp_malloc(req);
+	{ void *ra;
+
+#ifdef O_MREMAP
+	  if ( (ra=mremap(reg, reg->size, req, MREMAP_MAYMOVE)) != MAP_FAILED )
+	  { map_region *nw = ra;
+
+#ifdef O_DEBUG
+	    memset((char*)nw+nw->size, 0xFB, req-nw->size);
+#endif
+	    nw->size = req;
+	    return nw->data;
+	  }
+#endif
+
+	  ra = tmp_malloc(req);
 
 	  if ( ra )
 	  { memcpy(ra, mem, reg->size-SA_OFFSET);
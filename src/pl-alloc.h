@@ -110,6 +110,10 @@ void *		allocHeap(size_t n);
 void *		allocHeapOrHalt(size_t n);
 void		freeHeap(void *mem, size_t n);
 #endif /*DMALLOC*/
+void *		allocCachedHeap(size_t n);
+void		freeCachedHeap(void *mem, size_t n);
+void		freeHeapCache(PL_local_data_t *ld);
+void		cleanupHeapCache(void);
 bool		enableSpareStack(Stack s, bool always);
 void		enableSpareStacks(void);
 bool		outOfStack(void *stack, stack_overflow_action how);
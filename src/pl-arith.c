@@ -1482,10 +1482,16 @@ pl_ar_add(Number n1, Number n2, Number r)
 	r->type = V_INTEGER;
 	return true;
       }
-
+#ifdef O_MPZ_INT128
+      r->type = V_MPZ;
+      mpz_init_set_int128(r->value.mpz,
+			  (__int128)n1->value.i + n2->value.i);
+      return true;
+#else
       if ( !promoteIntNumber(n1) ||
 	   !promoteIntNumber(n2) )
 	fail;
+#endif
     }
     /*FALLTHROUGH*/
 #ifdef O_BIGNUM
@@ -1527,9 +1533,16 @@ ar_minus(Number n1, Number n2, Number r)
       if ( (n1->value.i >= 0 && n2->value.i < 0 && r->value.i <= 0) ||
 	   (n1->value.i < 0  && n2->value.i > 0 && r->value.i >= 0) )
       {					/* overflow */
+#ifdef O_MPZ_INT128
+	r->type = V_MPZ;
+	mpz_init_set_int128(r->value.mpz,
+			    (__int128)n1->value.i - n2->value.i);
+	succeed;
+#else
 	if ( !promoteIntNumber(n1) ||
 	     !promoteIntNumber(n2) )
 	  fail;
+#endif
       } else
       { r->type = V_INTEGER;
 	succeed;
@@ -3524,11 +3537,19 @@ ar_mul(Number n1, Number n2, Number r)
       { r->type = V_INTEGER;
 	succeed;
       }
-      /*FALLTHROUGH*/
-#ifdef O_BIGNUM
+#ifdef O_MPZ_INT128
+      r->type = V_MPZ;
+      mpz_init_set_int128(r->value.mpz,
+			  (__int128)n1->value.i * n2->value.i);
+      succeed;
+#elif defined(O_BIGNUM)
       promoteToMPZNumber(n1);
       promoteToMPZNumber(n2);
-
+      /*FALLTHROUGH*/
+#else
+      return PL_error("*", 2, NULL, ERR_EVALUATION, ATOM_int_overflow);
+#endif
+#ifdef O_BIGNUM
     case V_MPZ:
       mpz_init(r->value.mpz);
       r->type = V_MPZ;
@@ -3539,8 +3560,6 @@ ar_mul(Number n1, Number n2, Number r)
       mpq_init(r->value.mpq);
       mpq_mul(r->value.mpq, n1->value.mpq, n2->value.mpq);
       return check_mpq(r);
-#else
-      return PL_error("*", 2, NULL, ERR_EVALUATION, ATOM_int_overflow);
 #endif
     case V_FLOAT:
       r->value.f = n1->value.f * n2->value.f;
@@ -41,6 +41,7 @@
 #include "pl-fli.h"
 #include "pl-pro.h"
 #include "pl-read.h"
+#include "pl-metrics.h"
 #include "os/pl-ctype.h"
 #undef LD
 #define LD LOCAL_LD
@@ -1020,7 +1021,7 @@ pl_garbage_collect_atoms(void)
 { GET_LD
   int64_t oldcollected;
   int verbose = truePrologFlag(PLFLAG_TRACE_GC) && !LD->in_print_message;
-  double t;
+  double t, wt;
   sigset_t set;
   size_t reclaimed;
   int rc = true;
@@ -1044,6 +1045,7 @@ pl_garbage_collect_atoms(void)
   PL_LOCK(L_REHASH_ATOMS);
   blockSignals(&set);
   t = CpuTime(CPU_USER);
+  wt = WallTime();
   unmarkAtoms();
   markAtomsOnStacks(LD, NULL);
 #ifdef O_ENGINES
@@ -1057,6 +1059,7 @@ pl_garbage_collect_atoms(void)
   t = CpuTime(CPU_USER) - t;
   GD->atoms.gc_time += t;
   GD->atoms.gc++;
+  metric_observe(METRIC_AGC_PAUSE, WallTime()-wt);
   unblockSignals(&set);
   PL_UNLOCK(L_REHASH_ATOMS);
   LD->atoms.gc_active = false;
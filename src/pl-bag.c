@@ -132,6 +132,19 @@ clear_mem_pool(mem_pool *mp)
 
 #define FINDALL_MAGIC	0x37ac78fe
 
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Answers that are a small integer or an atom are stored as their word in
+the answer stack rather than as a record.  This avoids compiling such an
+answer to a record and copying it back to the global stack, which is the
+dominant cost of findall/3 over many small answers.  As with R_NOLOCK
+records, such atoms are not registered, but marked by markAtomsFindall().
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+typedef struct bag_answer
+{ Record	record;			/* Recorded answer or NULL */
+  word		value;			/* Inline answer if record is NULL */
+} bag_answer;
+
 typedef struct findall_bag
 { struct findall_bag *parent;		/* parent bag */
   int		magic;			/* FINDALL_MAGIC */
@@ -141,7 +154,7 @@ typedef struct findall_bag
   size_t	gsize;			/* required size on stack */
   mem_pool	records;		/* stored records */
   segstack	answers;		/* list of answers */
-  Record	answer_buf[64];		/* tmp space */
+  bag_answer	answer_buf[32];		/* tmp space */
 } findall_bag;
 
 typedef struct findall_state
@@ -182,7 +195,7 @@ PRED_IMPL("$new_findall_bag", 0, new_findall_bag, PL_FA_SIG_ATOMIC)
   bag->gsize		   = 0;
   bag->parent		   = state->bags;
   init_mem_pool(&bag->records);
-  initSegStack(&bag->answers, sizeof(Record),
+  initSegStack(&bag->answers, sizeof(bag_answer),
 	       sizeof(bag->answer_buf), bag->answer_buf);
   MEMORY_BARRIER();
   LD->bags->bags = bag;
@@ -246,11 +259,22 @@ add_findall_bag(DECL_LD term_t term, term_t count)
 		    ERR_PERMISSION, ATOM_append, cbag, term);
   }
 
-  if ( !(r = compileTermToHeap_ex(term, alloc_record, bag, R_NOLOCK)) )
-    return PL_no_memory();
-  if ( !pushRecordSegStack(&bag->answers, r) )
+  Word p = valTermRef(term);
+  bag_answer a;
+
+  deRef(p);
+  if ( isTaggedInt(*p) || isAtom(*p) )
+  { a.record = NULL;
+    a.value  = *p;
+  } else
+  { if ( !(r = compileTermToHeap_ex(term, alloc_record, bag, R_NOLOCK)) )
+      return PL_no_memory();
+    a.record = r;
+    a.value  = 0;
+    bag->gsize += r->gsize;
+  }
+  if ( !pushSegStack(&bag->answers, a, bag_answer) )
     return PL_no_memory();
-  bag->gsize += r->gsize;
   bag->solutions++;
 
   if ( bag->gsize + bag->solutions*3 > globalStackLimit()/sizeof(word) )
@@ -286,7 +310,7 @@ PRED_IMPL("$collect_findall_bag", 2, collect_findall_bag, 0)
   { size_t space = bag->gsize + bag->solutions*3;
     term_t list = PL_copy_term_ref(A2);
     term_t answer = PL_new_term_ref();
-    Record *rp;
+    bag_answer *ap;
     int rc;
 
     if ( !hasGlobalSpace(space) )
@@ -294,12 +318,18 @@ PRED_IMPL("$collect_findall_bag", 2, collect_findall_bag, 0)
 	return raiseStackOverflow(rc);
     }
 
-    while ( (rp=topOfSegStack(&bag->answers)) )
-    { Record r = *rp;
+    while ( (ap=topOfSegStack(&bag->answers)) )
+    { Record r = ap->record;
       DEBUG(MSG_NSOLS, Sdprintf("Retrieving answer\n"));
-      copyRecordToGlobal(answer, r, ALLOW_GC);
-      if (GD->atoms.gc_active)
-        markAtomsRecord(r);
+      if ( r )
+      { copyRecordToGlobal(answer, r, ALLOW_GC);
+	if (GD->atoms.gc_active)
+	  markAtomsRecord(r);
+      } else
+      { *valTermRef(answer) = ap->value;
+	if ( GD->atoms.gc_active && isAtom(ap->value) )
+	  markAtom(word2atom(ap->value));
+      }
       PL_cons_list(list, answer, list);
 #ifdef O_ATOMGC
 		/* see comment with scanSegStack() for synchronization details */
@@ -397,9 +427,12 @@ PRED_IMPL("$destroy_findall_bag", 0, destroy_findall_bag, 0)
 
 static void
 markAtomsAnswers(void *data)
-{ Record r = *((Record*)data);
+{ bag_answer *a = data;
 
-  markAtomsRecord(r);
+  if ( a->record )
+    markAtomsRecord(a->record);
+  else if ( isAtom(a->value) )
+    markAtom(word2atom(a->value));
 }
 
 
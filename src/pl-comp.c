@@ -391,6 +391,27 @@ typedef struct target_module
   Module	     module;		/* Module = TM_MODULE */
 } target_module;
 
+#define LC_MAX_KEY	256		/* max words in a local clause key */
+#define LC_MAX_VARS	64		/* max distinct variables */
+#define LC_MAX_ARGS	64		/* max argvars */
+#define LC_MAX_FILL	256		/* max frame slots we fill */
+
+typedef struct lc_fill			/* fill a frame slot from the goal */
+{ unsigned int	voffset;		/* Frame slot */
+  unsigned int	type;			/* LCF_VAR or LCF_ARG */
+  unsigned int	index;			/* Index into vars or args */
+} lc_fill;
+
+typedef struct lc_record		/* record slot fills in compilation */
+{ int		count;
+  bool		overflow;
+  struct
+  { unsigned int voffset;
+    bool	 var;
+    Word	 address;
+  } fills[LC_MAX_FILL];
+} lc_record;
+
 typedef struct
 { Module	module;			/* module to compile into */
   Clause	clause;			/* clause we are constructing */
@@ -414,6 +435,7 @@ typedef struct
 #endif
   term_t	warning_list;		/* see compiler_warning() */
   c_warning    *warnings;
+  lc_record    *record;			/* Record islocal frame slots */
   tmp_buffer	branch_varbuf;		/* Store for branch_vars */
   tmp_buffer	codes;			/* scratch code table */
 } compileInfo, *CompileInfo;
@@ -428,6 +450,8 @@ typedef struct
 #define output_indirect(ci, op, ptr) LDFUNC(output_indirect, ci, op, ptr)
 #define link_local_var(v, iv, ci) LDFUNC(link_local_var, v, iv, ci)
 #define make_atoms_reachable(p, sz, code) LDFUNC(make_atoms_reachable, p, sz, code)
+#define finish_local_clause(clause, codes, proc, module, cp) \
+	LDFUNC(finish_local_clause, clause, codes, proc, module, cp)
 #endif /*USE_LD_MACROS*/
 
 #define LDFUNC_DECLARATIONS
@@ -436,6 +460,9 @@ static boolex_t	link_local_var(Word v, int iv, CompileInfo ci);
 #if SIZEOF_CODE < SIZEOF_WORD
 static Word	make_atoms_reachable(Word p, size_t size, const Code code);
 #endif
+static boolex_t	finish_local_clause(const struct clause *clause,
+				    const code *codes,
+				    Procedure proc, Module module, Clause *cp);
 #undef LDFUNC_DECLARATIONS
 
 
@@ -1145,9 +1172,9 @@ right_recursion:
   if ( control && *head != ATOM_true )	  /* e.g. atomic goals */
     ci->head_unify = false;
 
-  if ( ci->subclausearg && (isString(*head) || isAttVar(*head)) )
+  if ( ci->subclausearg )		/* atomic or attvar */
   { DEBUG(MSG_COMP_ARGVAR,
-	  Sdprintf("argvar for %s\n", isString(*head) ? "string" : "attvar"));
+	  Sdprintf("argvar for %s\n", isAttVar(*head) ? "attvar" : "atomic"));
     ci->argvars++;
   }
 
@@ -1797,6 +1824,428 @@ Output_0(CompileInfo ci, vmi c)
 		 *	CODE GENERATION		*
 		 *******************************/
 
+		 /*******************************
+		 *   CACHED LOCAL COMPILATION	*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Meta-calling a control structure such as (A,B)  or \+G compiles the goal
+into a temporary `local' clause (see  compileClause() below). Loops that
+meta-call goals of the same shape, e.g., the   action of forall/2, thus
+compile the same code over and over   again.  We maintain a small, per
+thread, direct mapped cache of compiled local clauses.
+
+Local compilation does not embed the  arguments   of  subgoals  in the
+code: these are accessed through frame slots  that refer to the goal. The
+code only depends on the  control  structure,   the  functors  of the
+subgoals and the variable sharing pattern.   This is what lc_key_goal()
+collects as key. If we compile a clause,   we record which frame slots
+are filled from which variable or argument of the goal. A cache hit
+copies the code and fills the slots from the new goal.
+
+Goals that are large or use Var:Goal or Goal@Var are not cached. Neither
+is a clause if the order in which
+arguments are used by the compiler does not match the order in which
+lc_key_goal() visits the goal.  The cached   code refers to procedures.
+When a procedure is reclaimed, GD->procedures.reclaimed is incremented,
+invalidating all cached clauses.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define LC_CACHE_SIZE	64		/* Must be a power of 2 */
+#define LC_MAX_DEPTH	100		/* max nesting of control structures */
+
+#define LCK_FUNCTOR	1		/* key item types */
+#define LCK_ATOM	2
+#define LCK_VAR		3
+#define LCK_ARG		4
+
+#define LCF_VAR		0		/* lc_fill types */
+#define LCF_ARG		1
+
+typedef struct lc_entry
+{ unsigned int	hash;			/* hash of the key */
+  unsigned int	reclaimed;		/* GD->procedures.reclaimed */
+  Module	module;			/* compilation module */
+  size_t	key_size;		/* # words in key */
+  word	       *key;			/* the key */
+  int		nfill;			/* # slots to fill */
+  lc_fill      *fill;			/* slots to fill */
+  Clause	clause;			/* clause template */
+} lc_entry;
+
+struct local_clause_cache
+{ struct
+  { unsigned int hash;			/* hash of the key */
+    size_t	size;			/* # words in key */
+    int		nvars;			/* # distinct variables */
+    int		nargs;			/* # argvars */
+    word	key[LC_MAX_KEY];
+    Word	vars[LC_MAX_VARS];	/* distinct variables */
+    Word	args[LC_MAX_ARGS];	/* compound, string and attvar args */
+  } key;
+  lc_record	record;			/* compiler slot fills */
+  lc_entry	entries[LC_CACHE_SIZE];
+};
+
+typedef struct local_clause_cache *LocalClauseCache;
+
+static inline void
+record_local_fill(lc_record *r, unsigned int voffset, bool var, Word address)
+{ if ( r->count < LC_MAX_FILL )
+  { r->fills[r->count].voffset = voffset;
+    r->fills[r->count].var     = var;
+    r->fills[r->count].address = address;
+    r->count++;
+  } else
+  { r->overflow = true;
+  }
+}
+
+static bool
+lc_add(LocalClauseCache c, word type, word value)
+{ if ( c->key.size+2 > LC_MAX_KEY )
+    return false;
+  c->key.key[c->key.size++] = type;
+  c->key.key[c->key.size++] = value;
+
+  return true;
+}
+
+static bool
+lc_key_var(LocalClauseCache c, Word v)
+{ int i;
+
+  for(i=0; i<c->key.nvars; i++)
+  { if ( c->key.vars[i] == v )
+      return lc_add(c, LCK_VAR, i);
+  }
+  if ( i == LC_MAX_VARS )
+    return false;
+  c->key.vars[c->key.nvars++] = v;
+
+  return lc_add(c, LCK_VAR, i);
+}
+
+#define lc_key_arg(c, p) LDFUNC(lc_key_arg, c, p)
+static bool
+lc_key_arg(DECL_LD LocalClauseCache c, Word p)
+{ deRef(p);
+
+  if ( isVar(*p) )
+    return lc_key_var(c, p);
+  if ( c->key.nargs == LC_MAX_ARGS )
+    return false;
+  c->key.args[c->key.nargs++] = p;
+
+  return lc_add(c, LCK_ARG, 0);
+}
+
+#define lc_key_module(c, p) LDFUNC(lc_key_module, c, p)
+static bool
+lc_key_module(DECL_LD LocalClauseCache c, Word p)
+{ deRef(p);
+
+  return isAtom(*p) && lc_add(c, LCK_ATOM, *p);
+}
+
+#define lc_key_goal(c, g, depth) LDFUNC(lc_key_goal, c, g, depth)
+static bool
+lc_key_goal(DECL_LD LocalClauseCache c, Word g, int depth)
+{
+right_recursion:
+  deRef(g);
+
+  if ( isVar(*g) )
+    return lc_key_var(c, g);
+  if ( isAtom(*g) )
+    return lc_add(c, LCK_ATOM, *g);
+  if ( isTerm(*g) && depth < LC_MAX_DEPTH )
+  { Functor f = valueTerm(*g);
+    FunctorDef fd = valueFunctor(f->definition);
+    size_t arity = fd->arity;
+    Word a = f->arguments;
+
+    if ( !lc_add(c, LCK_FUNCTOR, f->definition) )
+      return false;
+
+    if ( isoff(fd, CONTROL_F) )
+    { for(; arity > 0; arity--, a++)
+      { if ( !lc_key_arg(c, a) )
+	  return false;
+      }
+      return true;
+    }
+
+    depth++;
+    if ( f->definition == FUNCTOR_colon2 )	/* Module:Goal */
+    { if ( !lc_key_module(c, &a[0]) )
+	return false;
+      g = &a[1];
+      goto right_recursion;
+    }
+#ifdef O_CALL_AT_MODULE
+    if ( f->definition == FUNCTOR_at_sign2 )	/* Goal@Module */
+    { if ( !lc_key_module(c, &a[1]) )
+	return false;
+      g = &a[0];
+      goto right_recursion;
+    }
+#endif
+    for(; arity > 1; arity--, a++)
+    { if ( !lc_key_goal(c, a, depth) )
+	return false;
+    }
+    g = a;
+    goto right_recursion;
+  }
+
+  return false;
+}
+
+
+#define local_clause_key(body, module) LDFUNC(local_clause_key, body, module)
+static LocalClauseCache
+local_clause_key(DECL_LD Word body, Module module)
+{ LocalClauseCache c;
+
+  if ( !(c=LD->comp.local_cache) )
+  { if ( !(c=malloc(sizeof(*c))) )
+      return NULL;
+    memset(c, 0, sizeof(*c));
+    LD->comp.local_cache = c;
+  }
+
+  c->key.size  = 0;
+  c->key.nvars = 0;
+  c->key.nargs = 0;
+  if ( !lc_add(c, LCK_ATOM, (word)module) ||
+       !lc_key_goal(c, body, 0) )
+    return NULL;
+  c->key.hash = MurmurHashAligned2(c->key.key, c->key.size*sizeof(word),
+				   MURMUR_SEED);
+
+  return c;
+}
+
+
+static lc_entry *
+lookup_local_clause(LocalClauseCache c, Module module)
+{ lc_entry *e = &c->entries[c->key.hash&(LC_CACHE_SIZE-1)];
+
+  if ( e->clause &&
+       e->hash == c->key.hash &&
+       e->module == module &&
+       e->key_size == c->key.size &&
+       e->reclaimed == GD->procedures.reclaimed &&
+       memcmp(e->key, c->key.key, c->key.size*sizeof(word)) == 0 )
+    return e;
+
+  return NULL;
+}
+
+
+static void
+free_local_clause_entry(lc_entry *e)
+{ free(e->key);
+  free(e->fill);
+  free(e->clause);
+  memset(e, 0, sizeof(*e));
+}
+
+
+/* Called by compileClauseGuarded() after successful compilation of
+   the goal for which local_clause_key() created the current key.
+*/
+
+#define store_local_clause(clause, codes, module) \
+	LDFUNC(store_local_clause, clause, codes, module)
+static void
+store_local_clause(DECL_LD const struct clause *clause, const code *codes,
+		   Module module)
+{ LocalClauseCache c = LD->comp.local_cache;
+  lc_record *r = &c->record;
+  lc_fill *fill;
+  int nargs = 0;
+  lc_entry *e;
+  Clause cl;
+
+  if ( r->overflow ||
+       !(fill = malloc(r->count*sizeof(*fill)+1)) )
+    return;
+
+  for(int i=0; i<r->count; i++)
+  { fill[i].voffset = r->fills[i].voffset;
+
+    if ( r->fills[i].var )
+    { int v;
+
+      for(v=0; v<c->key.nvars; v++)
+      { if ( c->key.vars[v] == r->fills[i].address )
+	  break;
+      }
+      if ( v == c->key.nvars )
+	goto nocache;
+      fill[i].type  = LCF_VAR;
+      fill[i].index = v;
+    } else
+    { if ( nargs == c->key.nargs || c->key.args[nargs] != r->fills[i].address )
+	goto nocache;
+      fill[i].type  = LCF_ARG;
+      fill[i].index = nargs++;
+    }
+  }
+  if ( nargs != c->key.nargs )
+    goto nocache;
+
+  e = &c->entries[c->key.hash&(LC_CACHE_SIZE-1)];
+  if ( e->clause )
+    free_local_clause_entry(e);
+
+  if ( !(cl=malloc(sizeofClause(clause->code_size))) ||
+       !(e->key=malloc(c->key.size*sizeof(word))) )
+  { free(cl);
+    goto nocache;
+  }
+  memcpy(cl, clause, sizeofClause(0));
+  memcpy(cl->codes, codes, clause->code_size*sizeof(code));
+  memcpy(e->key, c->key.key, c->key.size*sizeof(word));
+  e->hash      = c->key.hash;
+  e->reclaimed = GD->procedures.reclaimed;
+  e->module    = module;
+  e->key_size  = c->key.size;
+  e->nfill     = r->count;
+  e->fill      = fill;
+  e->clause    = cl;
+  return;
+
+nocache:
+  free(fill);
+}
+
+
+/* Instantiate a cached local clause for the goal `body` at lTop.  This
+   does the same as compileClauseGuarded() for a NULL head.
+*/
+
+#define instantiate_local_clause(e, cp, body, proc, module) \
+	LDFUNC(instantiate_local_clause, e, cp, body, proc, module)
+static ssize_t
+instantiate_local_clause(DECL_LD const lc_entry *e, Clause *cp, Word body,
+			 Procedure proc, Module module)
+{ LocalClauseCache c = LD->comp.local_cache;
+  LocalFrame fr = lTop;
+
+  if ( argFrameP(fr, e->clause->variables) >= (Word)lMax )
+    return LOCAL_OVERFLOW;
+
+  *varFrameP(fr, VAROFFSET(1)) = *body;
+  for(int i=0; i<e->nfill; i++)
+  { const lc_fill *f = &e->fill[i];
+    Word k = varFrameP(fr, f->voffset);
+
+    if ( f->type == LCF_VAR )
+    { *k = makeRefG(c->key.vars[f->index]);
+    } else
+    { Word a = c->key.args[f->index];
+
+      if ( isAttVar(*a) )
+	*k = makeRefG(a);
+      else
+	*k = *a;
+    }
+  }
+
+  return finish_local_clause(e->clause, e->clause->codes, proc, module, cp);
+}
+
+
+void
+freeLocalClauseCache(PL_local_data_t *ld)
+{ LocalClauseCache c;
+
+  if ( (c=ld->comp.local_cache) )
+  { ld->comp.local_cache = NULL;
+
+    for(int i=0; i<LC_CACHE_SIZE; i++)
+    { if ( c->entries[i].clause )
+	free_local_clause_entry(&c->entries[i]);
+    }
+    free(c);
+  }
+}
+
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+finish_local_clause() completes a local  clause   whose  frame slots are
+filled: it copies the clause  and  its  code   to  the  local stack and
+fills the frame at lTop.  See compileClause() for the layout.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+static boolex_t
+finish_local_clause(DECL_LD const struct clause *clause, const code *codes,
+		    Procedure proc, Module module, Clause *cp)
+{ size_t space;
+  LocalFrame fr = lTop;
+  Word p0 = argFrameP(fr, clause->variables);
+  Word p = p0;
+  ClauseRef cref = (ClauseRef)p;
+  Clause cl;
+
+					/* check space */
+  space = ( clause->variables*sizeof(word) +
+	    sizeofClause(clause->code_size) +
+	    SIZEOF_CREF_CLAUSE +
+	    sizeof(uintptr_t)*2 +	/* possible alignment */
+	    LOCAL_MARGIN +
+	    sizeof(struct choice)
+	  );
+  if ( !hasLocalSpace(space) )
+    return LOCAL_OVERFLOW;
+
+  p = addPointer(p, SIZEOF_CREF_CLAUSE);
+#if ALIGNOF_INT64_T != ALIGNOF_VOIDP
+  if ( (uintptr_t)p % sizeof(gen_t) != 0 )
+  { p = addPointer(p, sizeof(void*));
+    assert((uintptr_t)p % sizeof(gen_t) == 0);
+  }
+#endif
+  cref->next = NULL;
+  cref->value.clause = cl = (Clause)p;
+  memcpy(cl, clause, sizeofClause(0));
+  memcpy(cl->codes, codes, clause->code_size*sizeof(code));
+  p = addPointer(p, sizeofClause(clause->code_size));
+
+#if SIZEOF_CODE != ALIGNOF_WORD
+  if ( (uintptr_t)p % sizeof(word) != 0 )
+  { p = addPointer(p, sizeof(void*));
+    IS_WORD_ALIGNED(p);
+  }
+#endif
+
+#if SIZEOF_CODE < SIZEOF_WORD
+  p = make_atoms_reachable(p, clause->code_size, cl->codes);
+  if ( !p )
+    return LOCAL_OVERFLOW;
+#endif
+
+  cl->variables += (unsigned int)(p-p0);
+  fr->clause = cref;
+  fr->predicate = getProcDefinition(proc);
+  setNextFrameFlags(fr, environment_frame);
+  setContextModule(fr, module);
+
+  DEBUG(MSG_COMP_ARGVAR, Sdprintf("; now %d vars\n", clause->variables));
+  DEBUG(MSG_COMP_ARGVAR, vm_list(cl->codes, NULL));
+
+  lTop = (LocalFrame)p;
+  DEBUG(0, assert(argFrameP(fr, fr->clause->value.clause->variables)
+		  == (Word)lTop));
+
+  *cp = cl;
+  return true;
+}
+
+
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 compileClause()
 
@@ -1858,6 +2307,23 @@ compileClause(DECL_LD Clause *cp, Word head, Word body,
   ssize_t rc;
 
   ci.progress = 0;
+  ci.record = NULL;
+  if ( !head && !warnings )
+  { LocalClauseCache c;
+
+    if ( (c=local_clause_key(body, module)) )
+    { lc_entry *e;
+
+      if ( (e=lookup_local_clause(c, module)) )
+      { LD->comp.local_cache_hits++;
+	return instantiate_local_clause(e, cp, body, proc, module);
+      }
+      c->record.count = 0;
+      c->record.overflow = false;
+      ci.record = &c->record;
+    }
+    LD->comp.local_cache_misses++;
+  }
   initBuffer(&ci.codes);
 
   C_STACK_OVERFLOW_GUARDED(
@@ -2067,71 +2533,16 @@ Finish up the clause.
     ATOMIC_ADD(&GD->statistics.codes, clause.code_size);
     ATOMIC_INC(&GD->statistics.clauses);
   } else
-  { size_t space;
-    LocalFrame fr = lTop;
-    Word p0 = argFrameP(fr, clause.variables);
-    Word p = p0;
-    ClauseRef cref = (ClauseRef)p;
-
-    DEBUG(MSG_COMP_ARGVAR,
+  { DEBUG(MSG_COMP_ARGVAR,
 	  Sdprintf("%d argvars; %d prolog vars; %d vars",
 		   ci->argvars, clause.prolog_vars, clause.variables));
     assert(ci->argvars == ci->argvar);
 
-					/* check space */
-    space = ( clause.variables*sizeof(word) +
-	      sizeofClause(clause.code_size) +
-	      SIZEOF_CREF_CLAUSE +
-	      sizeof(uintptr_t)*2 +     /* possible alignment */
-	      LOCAL_MARGIN +
-	      sizeof(struct choice)
-	    );
-    if ( !hasLocalSpace(space) )
-    { rc = LOCAL_OVERFLOW;
-      goto exit_fail;
-    }
-
-    p = addPointer(p, SIZEOF_CREF_CLAUSE);
-#if ALIGNOF_INT64_T != ALIGNOF_VOIDP
-    if ( (uintptr_t)p % sizeof(gen_t) != 0 )
-    { p = addPointer(p, sizeof(void*));
-      assert((uintptr_t)p % sizeof(gen_t) == 0);
-    }
-#endif
-    cref->next = NULL;
-    cref->value.clause = cl = (Clause)p;
-    memcpy(cl, &clause, sizeofClause(0));
-    memcpy(cl->codes, baseBuffer(&ci->codes, code), sizeOfBuffer(&ci->codes));
-    p = addPointer(p, sizeofClause(clause.code_size));
-
-#if SIZEOF_CODE != ALIGNOF_WORD
-    if ( (uintptr_t)p % sizeof(word) != 0 )
-    { p = addPointer(p, sizeof(void*));
-      IS_WORD_ALIGNED(p);
-    }
-#endif
-
-#if SIZEOF_CODE < SIZEOF_WORD
-    p = make_atoms_reachable(p, clause.code_size,
-			     baseBuffer(&ci->codes, code));
-    if ( !p )
-    { rc = LOCAL_OVERFLOW;
+    if ( ci->record )
+      store_local_clause(&clause, baseBuffer(&ci->codes, code), module);
+    if ( (rc=finish_local_clause(&clause, baseBuffer(&ci->codes, code),
+				 proc, module, &cl)) != true )
       goto exit_fail;
-    }
-#endif
-
-    cl->variables += (unsigned int)(p-p0);
-    fr->clause = cref;
-    fr->predicate = getProcDefinition(proc);
-    setNextFrameFlags(fr, environment_frame);
-    setContextModule(fr, module);
-
-    DEBUG(MSG_COMP_ARGVAR, Sdprintf("; now %d vars\n", clause.variables));
-    DEBUG(MSG_COMP_ARGVAR, vm_list(cl->codes, NULL));
-
-    lTop = (LocalFrame)p;
-    DEBUG(0, assert(argFrameP(fr, fr->clause->value.clause->variables)
-		    == (Word)lTop));
   }
 
   discardBuffer(&ci->codes);
@@ -2583,6 +2994,8 @@ link_local_var(DECL_LD Word v, int iv, CompileInfo ci)
     return LOCAL_OVERFLOW;
   DEBUG(0, assert(vd->address < (Word)lBase));
   *k = makeRefG(vd->address);
+  if ( ci->record )
+    record_local_fill(ci->record, voffset, true, vd->address);
 
   return true;
 }
@@ -2604,6 +3017,15 @@ compileArgument(DECL_LD Word arg, int where, compileInfo *ci)
 
 right_recursion:
 
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+In `islocal' mode, constants are passed  using argvars as well. This way
+the code only depends on the shape of the goal, which allows for reusing
+it (see lc_key_goal()).
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  if ( ci->islocal && !(where&A_NOARGVAR) && isAtomic(*arg) )
+    goto argvar;
+
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 A void.  Generate either B_VOID or H_VOID.
 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -2770,6 +3192,8 @@ isvar:
       *k = makeRefG(arg);		/* a reference to avoid binding a */
     else				/* copy! */
       *k = *arg;
+    if ( ci->record )
+      record_local_fill(ci->record, voffset, false, arg);
     if ( ci->argvar < 3 )
     { Output_0(ci, B_VAR0 + ci->argvar);
     } else
@@ -56,6 +56,7 @@ void		initWamTable(void);
 void		cleanupWamTable(void);
 void		separate_vmi(int nop);
 void		freeVarDefs(PL_local_data_t *ld);
+void		freeLocalClauseCache(PL_local_data_t *ld);
 bool		get_head_and_body_clause(term_t clause,
 					 term_t head, term_t body,
 					 Module *m, int *flags);
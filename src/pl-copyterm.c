@@ -76,10 +76,12 @@ single cell on a segmented cell for each node processed. This means that
 the required stack size is at most 1/2th   of the size of the term being
 copied.
 
-mark_for_duplicate() could quite easily return  the required stack-size,
-avoiding stack-resizing during the actual copy.  This is much harder for
-mark_for_copy() and I doubt that this   makes  much difference in actual
-applications.
+mark_for_duplicate() returns an upper bound for  the required number of
+global stack cells. If the stack  is   too  small, do_copy_term() aborts
+before copying and copy_term_refs() grows the  stack to the required size
+in one step. Without this, duplicating a   huge term could perform a full
+copy for each stack doubling. This is   much harder for mark_for_copy()
+and I doubt that this makes much difference in actual applications.
 
 For copy_term/4 we first mark all variables  of the first argument using
 set_copy(). In mark_for_copy() we process these  variables and leave the
@@ -194,12 +196,13 @@ share_for_duplicate(DECL_LD const Functor t, const cp_options *options)
   return false;
 }
 
-#define mark_for_duplicate(p, options) \
-	LDFUNC(mark_for_duplicate, p, options)
+#define mark_for_duplicate(p, options, cells) \
+	LDFUNC(mark_for_duplicate, p, options, cells)
 
 static boolex_t
-mark_for_duplicate(DECL_LD Word p, const cp_options *options)
+mark_for_duplicate(DECL_LD Word p, const cp_options *options, size_t *cells)
 { term_agenda agenda;
+  size_t need = 0;
 
   initTermAgenda(&agenda, 1, p);
   while((p=nextTermAgenda(&agenda)))
@@ -209,6 +212,7 @@ mark_for_duplicate(DECL_LD Word p, const cp_options *options)
     { case TAG_ATTVAR:
       { if ( ison(options, COPY_ATTRS) )
 	{ p = valPAttVar(*p);
+	  need += 3;			/* see alloc_attvar() */
 	  goto again;
 	}
 	/*FALLTHROUGH*/
@@ -231,6 +235,7 @@ mark_for_duplicate(DECL_LD Word p, const cp_options *options)
 	    continue;
 	  }
 	  set_visited(t->definition);
+	  need += arity+1;
 	} else
 	{ if ( visited_once(t->definition) )
 	    set_shared(t->definition);
@@ -246,6 +251,7 @@ mark_for_duplicate(DECL_LD Word p, const cp_options *options)
     }
   }
   clearTermAgenda(&agenda);
+  *cells = need;
 
   return true;
 }
@@ -752,14 +758,17 @@ out:
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Both from and to  point  to  locations   on  the  global  stack. From is
-deferenced and to is a variable.
+deferenced and to is a variable.  If the  required size is known before
+copying and the global stack is too small, this returns GLOBAL_OVERFLOW
+without copying and sets `need` to the number of cells required.
 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
-#define do_copy_term(from, to, options) \
-	LDFUNC(do_copy_term, from, to, options)
+#define do_copy_term(from, to, options, need) \
+	LDFUNC(do_copy_term, from, to, options, need)
 
 static boolex_t
-do_copy_term(DECL_LD Word from, Word to, const cp_options *options)
+do_copy_term(DECL_LD Word from, Word to, const cp_options *options,
+	     size_t *need)
 { boolex_t rc;
 
 again:
@@ -790,10 +799,17 @@ again:
       return rc;
     }
   } else if ( isoff(options, COPY_ABSTRACT) )
-  { if ( (rc=mark_for_duplicate(from, options)) != true )
+  { size_t cells;
+
+    if ( (rc=mark_for_duplicate(from, options, &cells)) != true )
     { cp_unmark(from, options->flags);
       return rc;
     }
+    if ( !hasGlobalSpace(cells) )
+    { cp_unmark(from, options->flags);
+      *need = cells;
+      return GLOBAL_OVERFLOW;
+    }
   }
   initCyclicCopy();
   rc = copy_term(from, to, options);
@@ -819,6 +835,7 @@ copy_term_refs(DECL_LD term_t from, term_t to, term_t vars,
   { fid_t fid;
     boolex_t rc;
     Word dest, src;
+    size_t need = 0;
 
     if ( !(fid = PL_open_foreign_frame()) )
       return false;			/* no space */
@@ -835,7 +852,7 @@ copy_term_refs(DECL_LD term_t from, term_t to, term_t vars,
     { if ( mark_vars(vars, true) != true )
 	return PL_no_memory();
     }
-    rc = do_copy_term(src, dest, options);
+    rc = do_copy_term(src, dest, options, &need);
 
     if ( rc < 0 )			/* no space for copy */
     { PL_discard_foreign_frame(fid);
@@ -844,7 +861,10 @@ copy_term_refs(DECL_LD term_t from, term_t to, term_t vars,
       { if ( mark_vars(vars, false) != true )
 	  return PL_no_memory();
       }
-      if ( !makeMoreStackSpace(rc, ALLOW_SHIFT|ALLOW_GC) )
+      if ( need )
+      { if ( !ensureGlobalSpace(need, ALLOW_SHIFT|ALLOW_GC) )
+	  return false;
+      } else if ( !makeMoreStackSpace(rc, ALLOW_SHIFT|ALLOW_GC) )
 	return false;
       DEBUG(CHK_SECURE, checkStacks(NULL));
     } else
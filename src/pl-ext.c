@@ -487,6 +487,7 @@ DECL_PLIST(transaction);
 DECL_PLIST(undo);
 DECL_PLIST(error);
 DECL_PLIST(coverage);
+DECL_PLIST(metrics);
 #ifdef __EMSCRIPTEN__
 DECL_PLIST(wasm);
 #endif
@@ -567,6 +568,7 @@ initBuildIns(bool signonly)
 #ifdef O_COVERAGE
   REG_PLIST(coverage);
 #endif
+  REG_PLIST(metrics);
 #ifdef __EMSCRIPTEN__
   REG_PLIST(wasm);
 #endif
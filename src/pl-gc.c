@@ -52,6 +52,7 @@
 #include "pl-bag.h"
 #include "pl-wam.h"
 #include "pl-write.h"
+#include "pl-metrics.h"
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 This module is based on
@@ -580,6 +581,7 @@ gc_stat_start(DECL_LD gc_stats *stats, gc_reason_t reason)
   this->local	      = usedStack(local);
   this->prolog_time   = cpu - stats->thread_cpu;
   stats->thread_cpu   = cpu;
+  stats->wall_start   = WallTime();
 }
 
 #define gc_stat_end(stats) LDFUNC(gc_stat_end, stats)
@@ -587,6 +589,7 @@ static gc_stat *
 gc_stat_end(DECL_LD gc_stats *stats)
 { gc_stat *this = &stats->last[stats->last_index];
   double cpu = ThreadCPUTime(CPU_USER);
+  double pause = WallTime() - stats->wall_start;
 
   this->global_after  = usedStack(global);
   this->trail_after   = usedStack(trail);
@@ -601,6 +604,9 @@ gc_stat_end(DECL_LD gc_stats *stats)
   stats->totals.trail_gained  += this->trail_before  - this->trail_after;
   stats->totals.time	      += this->gc_time;
   stats->totals.collections++;
+  if ( pause > stats->totals.pause_max )
+    stats->totals.pause_max = pause;
+  metric_observe(METRIC_GC_PAUSE, pause);
 
   if ( gc_percentage(this) > 0.2 )
     PL_raise(SIG_TUNE_GC);
@@ -160,6 +160,11 @@ struct PL_global_data
     uint64_t	threads_finished;	/* # finished threads */
     double	thread_cputime;		/* Total CPU time of threads */
 #endif
+    struct
+    { uint64_t	committed;		/* # committed transactions */
+      uint64_t	conflicts;		/* # discarded due to a conflict */
+      double	commit_time;		/* Wall time to make commits visible */
+    } transactions;
     int		errors;			/* Printed error messages */
     int		warnings;		/* Printed warning messages */
   } statistics;
@@ -232,6 +237,13 @@ struct PL_global_data
   { TablePP	breakpoints;		/* Code -> Breakpoint table */
   } comp;
 
+  struct
+  { struct
+    { void     *free;			/* Objects freed by other threads */
+      size_t	count;			/* Approx. # objects in free */
+    } classes[HEAP_CACHE_CLASSES];
+  } heap_cache;
+
   struct
   { ExtensionCell _ext_head;		/* head of registered extensions */
     ExtensionCell _ext_tail;		/* tail of this chain */
@@ -361,6 +373,7 @@ struct PL_global_data
     Procedure	heartbeat0;		/* prolog:heartbeat/0 */
 
     int		static_dirty;		/* #static dirty procedures */
+    unsigned int reclaimed;		/* # reclaimed procedures */
 #ifdef O_CLAUSEGC
     TablePP	dirty;			/* Table of dirty procedures */
 #endif
@@ -386,6 +399,18 @@ struct PL_global_data
     int		cgc_space_factor;	/* Max total/margin garbage */
     double	cgc_stack_factor;	/* Price to scan stack space */
     double	cgc_clause_factor;	/* Pce to scan clauses */
+    double	cgc_max_pause;		/* Max time for a CGC slice (0: none) */
+    int64_t	cgc_slices;		/* # clause GC slices */
+    double	cgc_slice_time_max;	/* Longest slice (wall time) */
+    struct
+    { int	active;			/* A CGC cycle is in progress */
+      gen_t	start_gen;		/* Generation at which we marked */
+      buffer	pending;		/* Marked definitions to clean */
+      buffer	tr_starts;		/* Active transactions when marking */
+      size_t	removed;		/* Clauses removed in this cycle */
+      size_t	erased_pending;		/* Erased size at start of cycle */
+      double	time;			/* CPU time used by this cycle */
+    } cgc_cycle;
     Clause	top_clause;		/* See PL_open_query() */
     struct clause_ref top_cref;		/* Its reference */
   } clauses;
@@ -398,6 +423,8 @@ struct PL_global_data
     int		min_clauses;
   } clause_index;
 
+  metric_histogram metrics[METRIC_COUNT]; /* Latency histograms */
+
   struct
   { size_t	highest;		/* highest source file index */
     size_t	no_hole_before;		/* All filled before here */
@@ -645,8 +672,20 @@ struct PL_local_data
   { VarDef *	vardefs;		/* compiler variable analysis */
     size_t	nvardefs;
     size_t	filledVars;
+    struct local_clause_cache *local_cache; /* cached meta-call clauses */
+    uint64_t	local_cache_hits;	/* # local clauses from the cache */
+    uint64_t	local_cache_misses;	/* # compiled local clauses */
   } comp;
 
+  struct
+  { struct
+    { void     *free;			/* Free list of this size class */
+      unsigned	count;			/* # objects in free list */
+    } classes[HEAP_CACHE_CLASSES];
+    uint64_t	hits;			/* # allocations served from cache */
+    uint64_t	misses;			/* # allocations using allocHeap() */
+  } heap_cache;
+
   struct
   { Buffer	buffered;		/* Buffered events */
     int		delay_nesting;		/* How deeply is delay nested? */
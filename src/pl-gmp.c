@@ -1015,6 +1015,23 @@ mpz_init_set_si64(mpz_t mpz, int64_t i)
 #endif
 }
 
+#ifdef O_MPZ_INT128
+/* Initialise mpz from a 128-bit integer.  Used for the result of int64
+ * arithmetic that overflows, which avoids promoting the arguments and
+ * doing the operation in GMP.
+ */
+
+void
+mpz_init_set_int128(mpz_t mpz, __int128 i)
+{ unsigned __int128 u = i < 0 ? -(unsigned __int128)i : (unsigned __int128)i;
+
+  mpz_init(mpz);
+  mpz_import(mpz, sizeof(u), ORDER, 1, 0, 0, &u);
+  if ( i < 0 )
+    mpz_neg(mpz, mpz);
+}
+#endif
+
 #endif /*O_GMP*/
 
 static void
@@ -85,6 +85,9 @@ void	get_rational_no_int(word w, number *n);
 #define MPZ_LIMB_SIZE(n)	((n)->_mp_size)
 #define MPZ_LIMBS(n)		((n)->_mp_d)
 #define MPZ_STACK_EXTRA		(1)
+#ifdef HAVE_INT128
+#define O_MPZ_INT128 1			/* int64 overflow via __int128 */
+#endif
 #elif O_BF
 #include "libbf/bf_gmp.h"
 #include "pl-bf.h"
@@ -117,6 +120,9 @@ char *	skipMPQOnCharp(const char *data);
 bool	mpz_to_int64(mpz_t mpz, int64_t *i);
 int	mpz_to_uint64(mpz_t mpz, uint64_t *i);
 void	mpz_init_set_si64(mpz_t mpz, int64_t i);
+#ifdef O_MPZ_INT128
+void	mpz_init_set_int128(mpz_t mpz, __int128 i);
+#endif
 double	mpz_to_double(mpz_t n);
 double	mpq_to_double(mpq_t q);
 void	mpq_set_double(mpq_t q, double f);
@@ -1563,15 +1563,41 @@ typedef struct gc_stats
   int		last_index;
   int		aggr_index;
   double	thread_cpu;		/* Last thread CPU time */
+  double	wall_start;		/* Wall time at start of GC */
   gc_reason_t	request;		/* Requesting stack */
   struct
   { int64_t	collections;
     int64_t	global_gained;		/* global stack bytes collected */
     int64_t	trail_gained;		/* trail stack bytes collected */
     double	time;			/* time spent in collections */
+    double	pause_max;		/* longest collection (wall time) */
   } totals;
 } gc_stats;
 
+		 /*******************************
+		 *	 LATENCY METRICS	*
+		 *******************************/
+
+typedef enum
+{ METRIC_GC_PAUSE = 0,			/* Stack garbage collection */
+  METRIC_AGC_PAUSE,			/* Atom garbage collection */
+  METRIC_CGC_PAUSE,			/* Clause garbage collection slice */
+  METRIC_INDEX_BUILD,			/* Creating a JIT clause index */
+  METRIC_QUEUE_WAIT,			/* Blocking in thread_get_message() */
+  METRIC_TABLE_COMPLETION,		/* Creating to completing an SCC */
+  METRIC_COUNT
+} metric_id;
+
+#define METRIC_SUB_BITS	3		/* 8 sub-buckets: 12.5% precision */
+#define METRIC_BUCKETS	((64-METRIC_SUB_BITS+1)<<METRIC_SUB_BITS)
+
+typedef struct metric_histogram
+{ int64_t	count;			/* # observations */
+  int64_t	sum;			/* Sum of observations (nsec) */
+  int64_t	max;			/* Largest observation (nsec) */
+  int64_t	buckets[METRIC_BUCKETS]; /* Log-linear buckets */
+} metric_histogram;
+
 
 #define VM_DYNARGC    255	/* compute argcount dynamically */
 
@@ -1699,6 +1725,9 @@ struct clause_index
 };
 
 #define MAX_BLOCKS 20			/* allows for 2M threads */
+#define HEAP_CACHE_CLASSES 8		/* See allocCachedHeap() */
+#define HEAP_CACHE_MAX 1024		/* Max cached objects per class */
+#define HEAP_CACHE_SHARED_MAX 65536	/* Max shared objects per class */
 
 typedef struct local_definitions
 { Definition *blocks[MAX_BLOCKS];
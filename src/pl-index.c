@@ -42,6 +42,7 @@
 #include "os/pl-prologflag.h"
 #include "pl-fli.h"
 #include "pl-wam.h"
+#include "pl-metrics.h"
 #include <math.h>
 
 #undef LD
@@ -914,7 +915,7 @@ freeClauseListRef(ClauseRef cref)
 
     freeHeap(cl->args, arityFunctor(cref->d.key)*sizeof(*cl->args));
   }
-  freeHeap(cref, SIZEOF_CREF_LIST);
+  freeCachedHeap(cref, SIZEOF_CREF_LIST);
 }
 
 
@@ -963,7 +964,7 @@ unallocClauseIndexTable(ClauseIndex ci)
 
 static ClauseRef
 newClauseListRef(word key)
-{ ClauseRef cref = allocHeapOrHalt(SIZEOF_CREF_LIST);
+{ ClauseRef cref = allocCachedHeap(SIZEOF_CREF_LIST);
 
   memset(cref, 0, SIZEOF_CREF_LIST);
   cref->d.key = key;
@@ -1930,6 +1931,7 @@ static ClauseIndex
 hashDefinition(ClauseList clist, hash_hints *hints, IndexContext ctx)
 { ClauseIndex ci;
   ClauseIndex *cip;
+  double t0 = WallTime();
 
   DEBUG(MSG_JIT, Sdprintf("[%d] hashDefinition(%s, %s, %d) (%s)\n",
 			  PL_thread_self(),
@@ -1973,7 +1975,10 @@ See the test_cgc_1 test case in tests/GC/test_cgc_1.pl
   usleep(1000);
 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
-  return fill_clause_index(ci, clist, ctx);
+  ci = fill_clause_index(ci, clist, ctx);
+  metric_observe(METRIC_INDEX_BUILD, WallTime()-t0);
+
+  return ci;
 }
 
 
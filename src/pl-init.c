@@ -1488,7 +1488,13 @@ PL_initialise(int argc, char **argv)
 	     PL_put_string_chars(av+1, rcpathcopy) &&
 	     PL_call_predicate(NULL, PL_Q_NODEBUG, boot_message2, av)) ? 0 : 1);
   } else
-  { IOSTREAM *statefd = SopenZIP(GD->resources.DB, "$prolog/state.qlf", RC_RDONLY);
+  { int rcflags = RC_RDONLY;
+    const char *ra;
+    IOSTREAM *statefd;
+
+    if ( (ra=getenv("SWIPL_STATE_READAHEAD")) && ra[0] && !streq(ra, "0") )
+      rcflags |= RC_READAHEAD;			/* opt-in, see pl-zip.c */
+    statefd = SopenZIP(GD->resources.DB, "$prolog/state.qlf", rcflags);
 
     if ( statefd )
     { GD->bootsession = true;
@@ -1891,6 +1897,7 @@ emergency:
 #ifdef O_PLMT
     cleanupThreads();
 #endif
+    cleanupHeapCache();
     cleanupForeign();
     cleanupPaths();
     cleanupCodeToAtom();
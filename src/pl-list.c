@@ -41,6 +41,7 @@
 #include "pl-gc.h"
 #include "pl-wam.h"
 #include "pl-fli.h"
+#include <math.h>
 
 #undef LD
 #define LD LOCAL_LD
@@ -156,6 +157,200 @@ PRED_IMPL("$memberchk", 3, memberchk, 0)
 }
 
 
+		 /*******************************
+		 *	  LISTS OF NUMBERS	*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Fast paths for sum_list/2, max_list/2 and  min_list/2 from library(lists).
+These walk the list cells directly if the list is a proper list that
+only holds tagged integers or only holds floats.   They fail if the list
+is mixed, contains bigints, rationals or non-numbers, if an intermediate
+integer overflows or if a float result is not normal.  The library then
+falls back to the generic Prolog definition, which deals with promotion,
+the float flags and errors.
+
+Floats are added sequentially in list order such that the result is the
+same as for the Prolog definition.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+typedef enum
+{ NL_SUM,
+  NL_MAX,
+  NL_MIN
+} num_list_op;
+
+#define num_list_fold(list, result, op) \
+	LDFUNC(num_list_fold, list, result, op)
+
+static int
+num_list_fold(DECL_LD term_t list, term_t result, num_list_op op)
+{ Word l, tail;
+  intptr_t len;
+
+  l = valTermRef(list);
+  len = skip_list(l, &tail);
+  if ( !isNil(*tail) || len == 0 )
+    return false;
+
+  deRef(l);
+  Word h = HeadList(l);
+  deRef(h);
+
+  if ( isTaggedInt(*h) )
+  { long long acc = (op == NL_SUM ? 0 : valInt(*h));
+
+    while( len-- > 0 )
+    { h = HeadList(l);
+      deRef(h);
+      if ( !isTaggedInt(*h) )
+	return false;
+
+      long long i = valInt(*h);
+      switch(op)
+      { case NL_SUM:
+	  if ( __builtin_saddll_overflow(acc, i, &acc) )
+	    return false;
+	  break;
+	case NL_MAX:
+	  if ( i > acc )
+	    acc = i;
+	  break;
+	case NL_MIN:
+	  if ( i < acc )
+	    acc = i;
+	  break;
+      }
+      l = TailList(l);
+      deRef(l);
+    }
+
+    return PL_unify_int64(result, acc);
+  } else if ( isFloat(*h) )
+  { double acc = (op == NL_SUM ? 0.0 : valFloat(*h));
+
+    while( len-- > 0 )
+    { h = HeadList(l);
+      deRef(h);
+      if ( !isFloat(*h) )
+	return false;
+
+      double f = valFloat(*h);
+      switch(op)
+      { case NL_SUM:
+	  acc += f;
+	  if ( !(isnormal(acc) || acc == 0.0) )
+	    return false;
+	  break;
+	case NL_MAX:			/* see ar_max() */
+	  if ( isnan(f) )
+	    return false;
+	  if ( f > acc || (f == acc && signbit(acc)) )
+	    acc = f;
+	  break;
+	case NL_MIN:			/* see ar_min() */
+	  if ( isnan(f) )
+	    return false;
+	  if ( f < acc || (f == acc && signbit(f)) )
+	    acc = f;
+	  break;
+      }
+      l = TailList(l);
+      deRef(l);
+    }
+
+    return PL_unify_float(result, acc);
+  }
+
+  return false;
+}
+
+
+/** '$sum_list'(+List, -Sum) is semidet.
+ *  '$max_list'(+List, -Max) is semidet.
+ *  '$min_list'(+List, -Min) is semidet.
+ *
+ * Fast paths for homogeneous lists of  small integers or floats.  Fail
+ * if the fast path does not apply.
+ */
+
+static
+PRED_IMPL("$sum_list", 2, sum_list, 0)
+{ PRED_LD
+
+  return num_list_fold(A1, A2, NL_SUM);
+}
+
+static
+PRED_IMPL("$max_list", 2, max_list, 0)
+{ PRED_LD
+
+  return num_list_fold(A1, A2, NL_MAX);
+}
+
+static
+PRED_IMPL("$min_list", 2, min_list, 0)
+{ PRED_LD
+
+  return num_list_fold(A1, A2, NL_MIN);
+}
+
+
+/** '$numlist'(+Low, +High, -List) is semidet.
+ *
+ * Create the list [Low..High] directly  on   the  global stack.  Fails
+ * if Low or High is not a small integer, High < Low or List is not
+ * unbound.  The latter avoids allocating a huge list that cannot unify.
+ */
+
+static
+PRED_IMPL("$numlist", 3, numlist, 0)
+{ PRED_LD
+  Word p;
+  sword low, high;
+
+  if ( !PL_is_variable(A3) )
+    return false;
+  p = valTermRef(A1);
+  deRef(p);
+  if ( !isTaggedInt(*p) )
+    return false;
+  low = valInt(*p);
+  p = valTermRef(A2);
+  deRef(p);
+  if ( !isTaggedInt(*p) )
+    return false;
+  high = valInt(*p);
+  if ( high < low )
+    return false;
+
+  size_t len = (size_t)(high-low)+1;
+  term_t list = PL_new_term_ref();
+
+  if ( !list )
+    return false;
+  if ( !hasGlobalSpace(len*3) )
+  { int rc;
+
+    if ( (rc=ensureGlobalSpace(len*3, ALLOW_GC)) != true )
+      return raiseStackOverflow(rc);
+  }
+
+  p = gTop;
+  *valTermRef(list) = consPtr(p, TAG_COMPOUND|STG_GLOBAL);
+  for(sword i=low; i <= high; i++)
+  { p[0] = FUNCTOR_dot2;
+    p[1] = consInt(i);
+    p[2] = consPtr(&p[3], TAG_COMPOUND|STG_GLOBAL);
+    p += 3;
+  }
+  p[-1] = ATOM_nil;
+  gTop = p;
+
+  return PL_unify(A3, list);
+}
+
+
 		 /*******************************
 		 *	      SORTING		*
 		 *******************************/
@@ -257,10 +452,12 @@ struct List_Record
 	if ( order == SORT_DESC ) c = -c
 
 
+#define nat_sort(data, remove_dups, order) \
+	LDFUNC(nat_sort, data, remove_dups, order)
+
 static list
-nat_sort(list data, int remove_dups, sort_order order)
-{ GET_LD
-  list stack[64];			/* enough for biggest machine */
+nat_sort(DECL_LD list data, int remove_dups, sort_order order)
+{ list stack[64];			/* enough for biggest machine */
   list *sp = stack;
   int runs = 0;				/* total number of runs processed */
   list p, q, r, s;
@@ -364,6 +561,416 @@ nat_sort(list data, int remove_dups, sort_order order)
 }
 
 
+		 /*******************************
+		 *	 SPECIALISED SORTING	*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+If all keys are small integers or all keys are ISO Latin-1 atoms we avoid
+calling compareStandard() for each comparison.   The records are copied
+into an array of sort_cell structures that  hold a 64-bit sort key and a
+pointer to the record:
+
+  - For small integers we use an LSD radix sort.  The key is mapped such
+    that unsigned comparison gives the requested order.  Digits for which
+    all keys are the same are skipped.
+  - For atoms we use a merge sort on the array, where the sort key holds
+    the first 8 bytes of the atom text.  Only if the prefixes are equal
+    we compare the full text.
+
+Both sorts are stable and retain the first of a sequence of duplicates,
+so the result is the same as for nat_sort().  If we cannot allocate the
+array we fall back to nat_sort().
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define SPECIAL_SORT_MIN_LEN	64	/* Use nat_sort() for short lists */
+
+typedef enum
+{ KEYS_OTHER = 0,			/* anything */
+  KEYS_ATOMIC,				/* int, float, text atom or string */
+  KEYS_INT,				/* only small integers */
+  KEYS_ATOM				/* only ISO Latin-1 text atoms */
+} key_class;
+
+typedef struct sort_cell
+{ uint64_t key;				/* (prefix) sort key */
+  list	   rec;				/* record it belongs to */
+} sort_cell;
+
+/* Classify the keys of `len` contiguous records.
+ */
+
+static key_class
+classify_keys(list l, size_t len)
+{ PL_blob_t *type = NULL;
+  bool all_int = true, all_atom = true;
+
+  for(; len-- > 0; l++)
+  { word w = *l->item.key.as_ptr;
+
+    if ( isTaggedInt(w) )
+    { all_atom = false;
+    } else if ( isAtom(w) )
+    { Atom a = atomValue(w);
+
+      if ( isoff(a->type, PL_BLOB_TEXT) )
+	return KEYS_OTHER;
+      if ( a->type->compare || (type && a->type != type) )
+	all_atom = false;
+      type = a->type;
+      all_int = false;
+    } else if ( isFloat(w) || isString(w) )
+    { all_int = all_atom = false;
+    } else
+    { return KEYS_OTHER;
+    }
+  }
+
+  return all_int ? KEYS_INT : all_atom ? KEYS_ATOM : KEYS_ATOMIC;
+}
+
+static inline uint64_t
+int_sort_key(word w, sort_order order)
+{ uint64_t k = (uint64_t)(int64_t)valInt(w) ^ ((uint64_t)1<<63);
+
+  return order == SORT_ASC ? k : ~k;
+}
+
+static inline uint64_t
+atom_sort_key(word w)
+{ Atom a = atomValue(w);
+  const unsigned char *s = (const unsigned char *)a->name;
+  uint64_t k = 0;
+
+  for(size_t i=0; i<8; i++)
+    k = (k<<8) | (i < a->length ? s[i] : 0);
+
+  return k;
+}
+
+static int
+compare_atom_cells(const sort_cell *c1, const sort_cell *c2, sort_order order)
+{ int c;
+
+  if ( c1->key != c2->key )
+  { c = c1->key < c2->key ? -1 : 1;
+  } else
+  { word w1 = *c1->rec->item.key.as_ptr;
+    word w2 = *c2->rec->item.key.as_ptr;
+
+    if ( w1 == w2 )
+    { c = 0;
+    } else
+    { Atom a1 = atomValue(w1);
+      Atom a2 = atomValue(w2);
+      size_t l = a1->length <= a2->length ? a1->length : a2->length;
+
+      if ( !(c = memcmp(a1->name, a2->name, l)) )
+	c = SCALAR_TO_CMP(a1->length, a2->length);
+    }
+  }
+
+  return order == SORT_DESC ? -c : c;
+}
+
+static void
+merge_sort_atom_cells(sort_cell *cells, sort_cell *tmp, size_t len,
+		      sort_order order)
+{ if ( len < 2 )
+    return;
+
+  size_t half = len/2;
+  size_t i = 0, j = half, o = 0;
+
+  merge_sort_atom_cells(cells, tmp, half, order);
+  merge_sort_atom_cells(cells+half, tmp, len-half, order);
+  if ( compare_atom_cells(&cells[half-1], &cells[half], order) <= 0 )
+    return;				/* already in order */
+
+  while( i < half && j < len )
+  { if ( compare_atom_cells(&cells[j], &cells[i], order) < 0 )
+      tmp[o++] = cells[j++];
+    else
+      tmp[o++] = cells[i++];
+  }
+  while( i < half )
+    tmp[o++] = cells[i++];
+  memcpy(cells, tmp, o*sizeof(*cells));
+}
+
+/* LSD radix sort.  Returns the buffer holding the sorted cells, which
+ * is either `cells` or `tmp`.
+ */
+
+static sort_cell *
+radix_sort_cells(sort_cell *cells, sort_cell *tmp, size_t len)
+{ size_t counts[8][256] = {{0}};
+
+  for(size_t i=0; i<len; i++)
+  { uint64_t k = cells[i].key;
+
+    for(int d=0; d<8; d++, k >>= 8)
+      counts[d][k&0xff]++;
+  }
+
+  for(int d=0; d<8; d++)
+  { size_t *cnt = counts[d];
+    size_t pos = 0;
+    int shift = d*8;
+
+    if ( cnt[(cells[0].key>>shift)&0xff] == len )
+      continue;				/* all keys have the same digit */
+
+    for(int b=0; b<256; b++)
+    { size_t c = cnt[b];
+
+      cnt[b] = pos;
+      pos += c;
+    }
+    for(size_t i=0; i<len; i++)
+      tmp[cnt[(cells[i].key>>shift)&0xff]++] = cells[i];
+
+    sort_cell *t = cells;
+    cells = tmp;
+    tmp = t;
+  }
+
+  return cells;
+}
+
+/* Sort `len` linked records starting at `data` whose keys are of class
+ * KEYS_INT or KEYS_ATOM.  Returns NIL if we are out of memory.
+ */
+
+static list
+special_sort(list data, size_t len, key_class kc,
+	     int remove_dups, sort_order order)
+{ sort_cell *cells, *sorted;
+  size_t i;
+  list p;
+
+  if ( !(cells = malloc(2*len*sizeof(*cells))) )
+    return NIL;
+
+  for(p=data, i=0; p; p = p->next.as_ptr, i++)
+  { word w = *p->item.key.as_ptr;
+
+    cells[i].key = (kc == KEYS_INT ? int_sort_key(w, order)
+				   : atom_sort_key(w));
+    cells[i].rec = p;
+  }
+  assert(i == len);
+
+  if ( kc == KEYS_INT )
+  { sorted = radix_sort_cells(cells, cells+len, len);
+  } else
+  { merge_sort_atom_cells(cells, cells+len, len, order);
+    sorted = cells;
+  }
+
+  list first = p = sorted[0].rec;
+  for(i=1; i<len; i++)
+  { list r = sorted[i].rec;
+
+    if ( remove_dups && *r->item.key.as_ptr == *p->item.key.as_ptr )
+    { FREE(r);
+    } else
+    { p->next.as_ptr = r;
+      p = r;
+    }
+  }
+  p->next.as_ptr = NIL;
+  free(cells);
+
+  return first;
+}
+
+#define sort_chunk(data, len, kc, remove_dups, order) \
+	LDFUNC(sort_chunk, data, len, kc, remove_dups, order)
+
+static list
+sort_chunk(DECL_LD list data, size_t len, key_class kc,
+	   int remove_dups, sort_order order)
+{ if ( (kc == KEYS_INT || kc == KEYS_ATOM) && len >= SPECIAL_SORT_MIN_LEN )
+  { list l;
+
+    if ( (l=special_sort(data, len, kc, remove_dups, order)) )
+      return l;
+  }
+
+  return nat_sort(data, remove_dups, order);
+}
+
+
+		 /*******************************
+		 *	   PARALLEL SORT	*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Sorting long lists whose keys  are  all   small  integers,  floats, text
+atoms or strings  is  done  in   parallel.  The  (contiguous)  array  of
+List_Records is split into chunks that  are  sorted by sort_chunk() in
+worker threads, after which the sorted  chunks   are  merged by the
+calling thread.  Comparing these keys does   not modify the terms, does
+not allocate and only reads from  the   calling  engine, so the workers
+use the LD of the caller.  The caller is blocked while the workers run.
+Lists with only small integer keys are   not sorted in parallel as the
+radix sort is faster than merging the chunks.
+
+Merging always prefers the left (earlier)  chunk   on  ties, so the sort
+remains stable and, if  duplicates  are   removed,  the  first  one is
+retained, exactly as in the sequential   nat_sort().  The result is thus
+identical to the sequential version.
+
+The number of workers is bounded by the `cpu_count` flag.  Setting this
+flag to 1 disables parallel sorting.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#ifdef O_PLMT
+#define PAR_SORT_MIN_LEN	100000	/* Do not sort shorter lists in parallel */
+#define PAR_SORT_MIN_CHUNK	 50000	/* Minimal elements per worker */
+#define PAR_SORT_MAX_WORKERS	    16
+
+typedef struct sort_job
+{ PL_local_data_t *ld;			/* engine of the caller */
+  list		   data;		/* chunk to sort */
+  size_t	   len;			/* # records in chunk */
+  key_class	   kc;			/* class of the keys */
+  int		   remove_dups;
+  sort_order	   order;
+  pthread_t	   tid;
+  bool		   started;		/* worker thread is running */
+} sort_job;
+
+static void *
+sort_worker(void *closure)
+{ sort_job *job = closure;
+
+  WITH_LD(job->ld)
+    job->data = sort_chunk(job->data, job->len, job->kc,
+			   job->remove_dups, job->order);
+
+  return NULL;
+}
+
+#define merge_sorted(q, p, remove_dups, order) \
+	LDFUNC(merge_sorted, q, p, remove_dups, order)
+
+static list
+merge_sorted(DECL_LD list q, list p, int remove_dups, sort_order order)
+{ struct List_Record header;
+  list r = &header;
+  list s;
+
+  remove_dups = !remove_dups;		/* see nat_sort() */
+  while (q && p)
+  {	/* q precedes p */
+    compare(c, q, p);
+
+    if (c <= 0)
+    { r->next.as_ptr = q, r = q, q = q->next.as_ptr;
+      if (c == remove_dups)
+      { s = p->next.as_ptr;
+	FREE(p);
+	p = s;
+      }
+    } else
+    { r->next.as_ptr = p, r = p, p = p->next.as_ptr;
+    }
+  }
+  r->next.as_ptr = q ? q : p;
+
+  return header.next.as_ptr;
+}
+
+static int
+par_sort_workers(size_t len)
+{ int64_t cpus;
+  size_t n;
+
+  if ( !PL_current_prolog_flag(ATOM_cpu_count, PL_INTEGER, &cpus) || cpus < 2 )
+    return 1;
+  n = len/PAR_SORT_MIN_CHUNK;
+  if ( n > (size_t)cpus )
+    n = (size_t)cpus;
+  if ( n > PAR_SORT_MAX_WORKERS )
+    n = PAR_SORT_MAX_WORKERS;
+
+  return n < 2 ? 1 : (int)n;
+}
+
+#define par_sort(data, len, nw, kc, remove_dups, order) \
+	LDFUNC(par_sort, data, len, nw, kc, remove_dups, order)
+
+static list
+par_sort(DECL_LD list data, size_t len, int nw, key_class kc,
+	 int remove_dups, sort_order order)
+{ sort_job jobs[PAR_SORT_MAX_WORKERS];
+
+  for(int i=0; i<nw; i++)
+  { size_t from = len*i/nw;
+    size_t to   = len*(i+1)/nw;
+    sort_job *job = &jobs[i];
+
+    job->ld	     = LD;
+    job->data	     = data+from;
+    job->len	     = to-from;
+    job->kc	     = kc;
+    job->remove_dups = remove_dups;
+    job->order	     = order;
+    job->started     = false;
+    data[to-1].next.as_ptr = NIL;
+    if ( i > 0 )			/* the caller sorts chunk 0 */
+      job->started = (pthread_create(&job->tid, NULL, sort_worker, job) == 0);
+  }
+
+  for(int i=0; i<nw; i++)
+  { sort_job *job = &jobs[i];
+
+    if ( job->started )
+      pthread_join(job->tid, NULL);
+    else
+      sort_worker(job);
+  }
+
+  for(int step=1; step < nw; step *= 2)
+  { for(int i=0; i+step < nw; i += step*2)
+      jobs[i].data = merge_sorted(jobs[i].data, jobs[i+step].data,
+				  remove_dups, order);
+  }
+
+  return jobs[0].data;
+}
+
+#endif /*O_PLMT*/
+
+/* Sort the `len` records starting at `data`.  The records are
+ * contiguous and linked in order.
+ */
+
+#define sort_records(data, len, remove_dups, order) \
+	LDFUNC(sort_records, data, len, remove_dups, order)
+
+static list
+sort_records(DECL_LD list data, size_t len, int remove_dups, sort_order order)
+{ key_class kc = KEYS_OTHER;
+
+  if ( len >= SPECIAL_SORT_MIN_LEN )
+    kc = classify_keys(data, len);
+
+#ifdef O_PLMT
+  int nw;
+
+  if ( (kc == KEYS_ATOMIC || kc == KEYS_ATOM) &&
+       len >= PAR_SORT_MIN_LEN &&
+       (nw=par_sort_workers(len)) >= 2 )
+    return par_sort(data, len, nw, kc, remove_dups, order);
+#endif
+
+  return sort_chunk(data, len, kc, remove_dups, order);
+}
+
+
 #define extract_key(p1, argc, argv, pair) LDFUNC(extract_key, p1, argc, argv, pair)
 static Word
 extract_key(DECL_LD Word p1, int argc, const word *argv, int pair)
@@ -561,7 +1168,7 @@ pl_nat_sort(DECL_LD term_t in, term_t out,
     case SORT_SORT:
     default:
     { term_t tmp = PL_new_term_ref();
-      l = nat_sort(l, remove_dups, order);
+      l = sort_records(l, ((Word)top-(Word)l)/3, remove_dups, order);
       put_sort_list(tmp, l);
       gTop = top;
       DEBUG(CHK_SECURE, checkStacks(NULL));
@@ -741,6 +1348,10 @@ BeginPredDefs(list)
   PRED_DEF("is_list",	 1, is_list,   0)
   PRED_DEF("$length",	 2, dlength,   0)
   PRED_DEF("$memberchk", 3, memberchk, 0)
+  PRED_DEF("$sum_list",	 2, sum_list,  0)
+  PRED_DEF("$max_list",	 2, max_list,  0)
+  PRED_DEF("$min_list",	 2, min_list,  0)
+  PRED_DEF("$numlist",	 3, numlist,   0)
   PRED_DEF("sort",	 2, sort,      PL_FA_ISO)
   PRED_DEF("msort",	 2, msort,     0)
   PRED_DEF("keysort",	 2, keysort,   PL_FA_ISO)
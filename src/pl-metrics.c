@@ -0,0 +1,179 @@
+/*  Part of SWI-Prolog
+
+    Author:        agent
+    E-mail:        agent@local
+    WWW:           http://www.swi-prolog.org
+    Copyright (c)  2026, agent
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in
+       the documentation and/or other materials provided with the
+       distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "pl-metrics.h"
+#include <math.h>
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Latency histograms for events that  pause   or  block Prolog threads. The
+histograms are global and updated using atomic instructions only, so
+recording an observation never takes a lock.  Observations are kept in
+nanoseconds using log-linear buckets  in   the  style of HdrHistogram:
+values below 2^METRIC_SUB_BITS have a bucket  of their own; larger values
+are split by their most significant bit into 2^METRIC_SUB_BITS linear
+sub-buckets.  This gives a relative error of at most 12.5% over the full
+64-bit range at a fixed cost of 4Kb per histogram.
+
+'$metrics'/1 takes a snapshot without stopping writers.  The snapshot is
+therefore not atomic: as metric_observe() updates the bucket before
+`count`, the buckets may hold  observations   that  are not yet in
+`count`, but never the other way around.  This is acceptable for
+monitoring.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+static const char *metric_names[METRIC_COUNT] =
+{ "gc_pause",
+  "agc_pause",
+  "cgc_pause",
+  "index_build",
+  "queue_wait",
+  "table_completion"
+};
+
+static inline int
+metric_bucket(int64_t v)
+{ int e;
+
+  if ( v < (1<<METRIC_SUB_BITS) )
+    return v < 0 ? 0 : (int)v;
+
+  e = MSB64(v);
+  return ( ((e-METRIC_SUB_BITS+1)<<METRIC_SUB_BITS) +
+	   (int)((v>>(e-METRIC_SUB_BITS)) & ((1<<METRIC_SUB_BITS)-1)) );
+}
+
+/* Exclusive upper bound of a bucket in nanoseconds */
+
+static double
+metric_bucket_limit(int i)
+{ int sub = (1<<METRIC_SUB_BITS);
+
+  if ( i < sub )
+  { return (double)(i+1);
+  } else
+  { int shift = (i>>METRIC_SUB_BITS) - 1;
+    int m     = i & (sub-1);
+
+    return ldexp((double)(sub+m+1), shift);
+  }
+}
+
+void
+metric_observe(metric_id id, double seconds)
+{ metric_histogram *h = &GD->metrics[id];
+  int64_t ns = (int64_t)(seconds*1e9);
+  int64_t max;
+
+  if ( ns < 0 )
+    ns = 0;
+
+  ATOMIC_INC(&h->buckets[metric_bucket(ns)]);
+  ATOMIC_ADD(&h->sum, ns);
+  ATOMIC_INC(&h->count);
+  while( ns > (max=h->max) &&
+	 !COMPARE_AND_SWAP_INT64(&h->max, max, ns) )
+    ;
+}
+
+		 /*******************************
+		 *      PROLOG CONNECTION	*
+		 *******************************/
+
+#define unify_histogram(t, h) LDFUNC(unify_histogram, t, h)
+
+static int
+unify_histogram(DECL_LD term_t t, const metric_histogram *h)
+{ term_t tail = PL_copy_term_ref(t);
+  term_t head = PL_new_term_ref();
+  int last = METRIC_BUCKETS;
+
+  while( last > 0 && h->buckets[last-1] == 0 )
+    last--;
+
+  for(int i=0; i<last; i++)
+  { if ( !PL_unify_list(tail, head, tail) ||
+	 !PL_unify_term(head,
+			PL_FUNCTOR, FUNCTOR_minus2,
+			  PL_FLOAT, metric_bucket_limit(i)/1e9,
+			  PL_INT64, h->buckets[i]) )
+      return false;
+  }
+
+  return PL_unify_nil(tail);
+}
+
+/** '$metrics'(-Metrics) is det.
+ *
+ * Metrics is a list Name-histogram(Count, Sum, Max, Buckets), where
+ * Sum and Max are in seconds and Buckets is a list UpperBound-Count
+ * holding all buckets in ascending order up to the highest non-empty
+ * one.  The empty buckets are included such that a client always sees
+ * the same bucket bounds.
+ */
+
+static
+PRED_IMPL("$metrics", 1, metrics, 0)
+{ PRED_LD
+  term_t tail = PL_copy_term_ref(A1);
+  term_t head = PL_new_term_ref();
+  term_t buckets = PL_new_term_ref();
+
+  for(int id=0; id<METRIC_COUNT; id++)
+  { const metric_histogram *h = &GD->metrics[id];
+
+    PL_put_variable(buckets);
+    if ( !PL_unify_list(tail, head, tail) ||
+	 !PL_unify_term(head,
+			PL_FUNCTOR, FUNCTOR_minus2,
+			  PL_CHARS, metric_names[id],
+			  PL_FUNCTOR, FUNCTOR_histogram4,
+			    PL_INT64, h->count,
+			    PL_FLOAT, (double)h->sum/1e9,
+			    PL_FLOAT, (double)h->max/1e9,
+			    PL_TERM, buckets) ||
+	 !unify_histogram(buckets, h) )
+      return false;
+  }
+
+  return PL_unify_nil(tail);
+}
+
+		 /*******************************
+		 *      PUBLISH PREDICATES	*
+		 *******************************/
+
+BeginPredDefs(metrics)
+  PRED_DEF("$metrics", 1, metrics, 0)
+EndPredDefs
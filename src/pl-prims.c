@@ -5887,6 +5887,9 @@ swi_statistics(DECL_LD atom_t key, Number v)
   } else if (key == ATOM_gctime)
   { v->type = V_FLOAT;
     v->value.f = LD->gc.stats.totals.time;
+  } else if (key == ATOM_gc_pause_max)
+  { v->type = V_FLOAT;
+    v->value.f = LD->gc.stats.totals.pause_max;
   } else if (key == ATOM_collections)
     v->value.i = LD->gc.stats.totals.collections;
   else if (key == ATOM_collected)
@@ -5913,6 +5916,12 @@ swi_statistics(DECL_LD atom_t key, Number v)
   { v->type = V_FLOAT;
     v->value.f = GD->clauses.cgc_time;
   }
+  else if (key == ATOM_cgc_slices)
+    v->value.i = GD->clauses.cgc_slices;
+  else if (key == ATOM_cgc_slice_time_max)
+  { v->type = V_FLOAT;
+    v->value.f = GD->clauses.cgc_slice_time_max;
+  }
 #endif
   else if (key == ATOM_global_shifts)
     v->value.i = LD->shift_status.global_shifts;
@@ -5944,6 +5953,22 @@ swi_statistics(DECL_LD atom_t key, Number v)
   } else if ( key == ATOM_threads_peak )
     v->value.i = GD->thread.peak_id;
 #endif
+  else if (key == ATOM_transactions_committed)
+    v->value.i = GD->statistics.transactions.committed;
+  else if (key == ATOM_transaction_conflicts)
+    v->value.i = GD->statistics.transactions.conflicts;
+  else if (key == ATOM_transaction_commit_time)
+  { v->type = V_FLOAT;
+    v->value.f = GD->statistics.transactions.commit_time;
+  }
+  else if (key == ATOM_metacall_cache_hits)
+    v->value.i = LD->comp.local_cache_hits;
+  else if (key == ATOM_metacall_cache_misses)
+    v->value.i = LD->comp.local_cache_misses;
+  else if (key == ATOM_heap_cache_hits)
+    v->value.i = LD->heap_cache.hits;
+  else if (key == ATOM_heap_cache_misses)
+    v->value.i = LD->heap_cache.misses;
   else if (key == ATOM_table_space_used)
   { alloc_pool *pool;
     if ( (pool=LD->tabling.node_pool) )
@@ -52,6 +52,7 @@
 #include "pl-fli.h"
 #include "pl-gc.h"
 #include "pl-funct.h"
+#include "pl-metrics.h"
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 General  handling  of  procedures:  creation;  adding/removing  clauses;
@@ -290,6 +291,7 @@ unallocProcedure(Procedure proc)
   }
   if ( proc->source_no )
     releaseSourceFileNo(proc->source_no);
+  ATOMIC_INC(&GD->procedures.reclaimed);	/* see store_local_clause() */
   freeHeap(proc, sizeof(*proc));
 }
 
@@ -1211,7 +1213,7 @@ release_clause(Clause cl)
 
 ClauseRef
 newClauseRef(Clause clause, word key)
-{ ClauseRef cref = allocHeapOrHalt(SIZEOF_CREF_CLAUSE);
+{ ClauseRef cref = allocCachedHeap(SIZEOF_CREF_CLAUSE);
 
   DEBUG(MSG_CGC_CREF_PL,
 	Sdprintf("/**/ a(%p, %p, %d, '%s').\n",
@@ -1237,7 +1239,7 @@ freeClauseRef(ClauseRef cref)
 
   release_clause(cl);
 
-  freeHeap(cref, SIZEOF_CREF_CLAUSE);
+  freeCachedHeap(cref, SIZEOF_CREF_CLAUSE);
 }
 
 
@@ -2667,99 +2669,152 @@ maybeUnregisterDirtyDefinition(Definition def)
 
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+A CGC cycle consists of  a  marking   phase  that  scans  all engines for
+accessed predicates, followed  by  cleaning   the  marked  predicates. The
+marking result remains valid as long   as the DDI_MARKING flag is set and
+we only reclaim clauses that were erased   before the start generation of
+the cycle. This allows us to spread the  cleaning phase over a number of
+_slices_, each limited to GD->clauses.cgc_max_pause   seconds.  The slice
+granularity is a single predicate.
+
+Slices are run by garbageCollectClausesSlice(), either from the gc thread
+or from the signal handler  of   a  worker  thread. If work remains, the
+slice re-signals CGC such that the next slice is scheduled after pending
+work (e.g., atom GC or the normal execution of the worker) has been done.
+
 (*) We set the initial generation to   GEN_MAX  to know which predicates
 have been marked. We can only reclaim   clauses  that were erased before
 the start generation of the clause garbage collector.
 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
-foreign_t
-pl_garbage_collect_clauses(void)
-{ GET_LD
-  bool rc = true;
+#define cgc_start_cycle(_) LDFUNC(cgc_start_cycle, _)
+static bool
+cgc_start_cycle(DECL_LD)
+{ int verbose = truePrologFlag(PLFLAG_TRACE_GC) && !LD->in_print_message;
+  Buffer pending = &GD->clauses.cgc_cycle.pending;
+  Buffer tr_starts = &GD->clauses.cgc_cycle.tr_starts;
+
+  if ( verbose )
+  { if ( !printMessage(ATOM_informational,
+		       PL_FUNCTOR_CHARS, "cgc", 1,
+			 PL_CHARS, "start") )
+      return false;
+  }
 
-  if ( GD->procedures.dirty->size > 0 &&
-       COMPARE_AND_SWAP_INT(&GD->clauses.cgc_active, false, true) )
-  { size_t removed = 0;
-    size_t erased_pending = GD->clauses.erased_size;
-    double gct, t0 = ThreadCPUTime(CPU_USER);
-    gen_t start_gen = global_generation();
-    int verbose = truePrologFlag(PLFLAG_TRACE_GC) && !LD->in_print_message;
-    tmp_buffer tr_starts;
-
-    if ( verbose )
-    { if ( (rc=printMessage(ATOM_informational,
-			    PL_FUNCTOR_CHARS, "cgc", 1,
-			      PL_CHARS, "start")) == false )
-	goto out;
-    }
+  GD->clauses.cgc_cycle.start_gen      = global_generation();
+  GD->clauses.cgc_cycle.removed        = 0;
+  GD->clauses.cgc_cycle.erased_pending = GD->clauses.erased_size;
+  GD->clauses.cgc_cycle.time           = 0.0;
 
-    DEBUG(MSG_CGC, Sdprintf("CGC @ %lld ... ", start_gen));
-    DEBUG(MSG_CGC_STACK,
-	  { Sdprintf("CGC @ %lld ... ", start_gen);
-	    PL_backtrace(5,0);
-	  });
+  DEBUG(MSG_CGC, Sdprintf("CGC @ %lld ... ", GD->clauses.cgc_cycle.start_gen));
+  DEBUG(MSG_CGC_STACK,
+	{ Sdprintf("CGC @ %lld ... ", GD->clauses.cgc_cycle.start_gen);
+	  PL_backtrace(5,0);
+	});
 
+  initBuffer(pending);
+  initBuffer(tr_starts);
 					/* sanity-check */
-    FOR_TABLE(GD->procedures.dirty, n, v)
-    { DirtyDefInfo ddi = val2ptr(v);
-
-      DEBUG(CHK_SECURE,
-	    { Definition def = key2ptr(n);
-	      LOCKDEF(def);
-	      checkDefinition(def);
-	      UNLOCKDEF(def);
-	    });
-      ddi_reset(ddi);			  /* see (*) */
-    }
+  FOR_TABLE(GD->procedures.dirty, n, v)
+  { Definition def = key2ptr(n);
+    DirtyDefInfo ddi = val2ptr(v);
+
+    DEBUG(CHK_SECURE,
+	  { LOCKDEF(def);
+	    checkDefinition(def);
+	    UNLOCKDEF(def);
+	  });
+    ddi_reset(ddi);			  /* see (*) */
+    addBuffer(pending, def, Definition);
+  }
 
-    initBuffer(&tr_starts);
-    markPredicatesInEnvironments(LD, (Buffer)&tr_starts);
+  markPredicatesInEnvironments(LD, tr_starts);
 #ifdef O_ENGINES
-    forThreadLocalDataUnsuspended(markPredicatesInEnvironments,
-				  (Buffer)&tr_starts);
+  forThreadLocalDataUnsuspended(markPredicatesInEnvironments, tr_starts);
 #endif
 
-    DEBUG(MSG_CGC, Sdprintf("(marking done)\n"));
-
-    FOR_TABLE(GD->procedures.dirty, n, v)
-    { Definition def = key2ptr(n);
-      DirtyDefInfo ddi = val2ptr(v);
-
-      if ( isoff(def, P_FOREIGN) &&
-	   def->impl.clauses.erased_clauses > 0 )
-      { size_t del = cleanDefinition(def, ddi,
-				     start_gen, (Buffer)&tr_starts,
-				     &rc);
-
-	removed += del;
-	DEBUG(MSG_CGC_PRED,
-	      Sdprintf("cleanDefinition(%s, %s): "
-		       "%zd clauses (left %d)\n",
-		       predicateName(def),
-		       ddi_generation_name(ddi),
-		       del,
-		       (int)def->impl.clauses.erased_clauses));
-      }
+  DEBUG(MSG_CGC, Sdprintf("(marking done)\n"));
+  GD->clauses.cgc_cycle.active = true;
+
+  return true;
+}
+
 
-      maybeUnregisterDirtyDefinition(def);
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Clean marked definitions until we are  done   or  we exceed `max_pause`
+seconds after `t0`. Returns true if the cycle is completed.  Predicates
+that are no longer in the dirty table  or were registered after we did
+the marking (and thus do not have DDI_MARKING) are skipped.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define cgc_clean_pending(t0, max_pause, rcp) \
+	LDFUNC(cgc_clean_pending, t0, max_pause, rcp)
+static bool
+cgc_clean_pending(DECL_LD double t0, double max_pause, bool *rcp)
+{ Buffer pending = &GD->clauses.cgc_cycle.pending;
+  gen_t start_gen = GD->clauses.cgc_cycle.start_gen;
+
+  while( !isEmptyBuffer(pending) )
+  { Definition def = popBuffer(pending, Definition);
+    DirtyDefInfo ddi;
+
+    if ( !(ddi=lookupHTablePP(GD->procedures.dirty, def)) ||
+	 isoff(ddi, DDI_MARKING) )
+      continue;
+
+    if ( isoff(def, P_FOREIGN) &&
+	 def->impl.clauses.erased_clauses > 0 )
+    { size_t del = cleanDefinition(def, ddi,
+				   start_gen, &GD->clauses.cgc_cycle.tr_starts,
+				   rcp);
+
+      GD->clauses.cgc_cycle.removed += del;
+      DEBUG(MSG_CGC_PRED,
+	    Sdprintf("cleanDefinition(%s, %s): "
+		     "%zd clauses (left %d)\n",
+		     predicateName(def),
+		     ddi_generation_name(ddi),
+		     del,
+		     (int)def->impl.clauses.erased_clauses));
     }
 
-    discardBuffer(&tr_starts);
-    gcClauseRefs();
-    GD->clauses.cgc_count++;
-    GD->clauses.cgc_reclaimed	+= removed;
-    GD->clauses.cgc_time        += (gct=ThreadCPUTime(CPU_USER) - t0);
-    GD->clauses.erased_size_last = GD->clauses.erased_size;
-
-    DEBUG(MSG_CGC, Sdprintf("CGC: removed %ld clauses "
-			    "(%ld bytes reclaimed, %ld pending) in %2f sec.\n",
-			    (long)removed,
-			    (long)erased_pending - GD->clauses.erased_size,
-			    (long)GD->clauses.erased_size,
-			    gct));
-
-    if ( verbose )
-      rc = printMessage(
+    maybeUnregisterDirtyDefinition(def);
+
+    if ( max_pause > 0.0 && !isEmptyBuffer(pending) &&
+	 WallTime() - t0 > max_pause )
+      return false;
+  }
+
+  return true;
+}
+
+
+#define cgc_finish_cycle(_) LDFUNC(cgc_finish_cycle, _)
+static bool
+cgc_finish_cycle(DECL_LD)
+{ int verbose = truePrologFlag(PLFLAG_TRACE_GC) && !LD->in_print_message;
+  size_t removed = GD->clauses.cgc_cycle.removed;
+  size_t erased_pending = GD->clauses.cgc_cycle.erased_pending;
+  double gct = GD->clauses.cgc_cycle.time;
+
+  discardBuffer(&GD->clauses.cgc_cycle.pending);
+  discardBuffer(&GD->clauses.cgc_cycle.tr_starts);
+  GD->clauses.cgc_cycle.active = false;
+
+  gcClauseRefs();
+  GD->clauses.cgc_count++;
+  GD->clauses.cgc_reclaimed	+= removed;
+  GD->clauses.erased_size_last = GD->clauses.erased_size;
+
+  DEBUG(MSG_CGC, Sdprintf("CGC: removed %ld clauses "
+			  "(%ld bytes reclaimed, %ld pending) in %2f sec.\n",
+			  (long)removed,
+			  (long)erased_pending - GD->clauses.erased_size,
+			  (long)GD->clauses.erased_size,
+			  gct));
+
+  if ( verbose )
+    return printMessage(
 	      ATOM_informational,
 	      PL_FUNCTOR_CHARS, "cgc", 1,
 		PL_FUNCTOR_CHARS, "done", 4,
@@ -2768,6 +2823,45 @@ pl_garbage_collect_clauses(void)
 		  PL_INT64,  (int64_t)GD->clauses.erased_size,
 		  PL_DOUBLE, gct);
 
+  return true;
+}
+
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Run a single CGC slice of at most  `max_pause` seconds (0.0: no limit).
+If no cycle is in progress, start one.  `done` is set to false if the
+cycle has not been completed.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define clause_gc_slice(max_pause, done) LDFUNC(clause_gc_slice, max_pause, done)
+static bool
+clause_gc_slice(DECL_LD double max_pause, bool *done)
+{ bool rc = true;
+
+  *done = true;
+  if ( (GD->clauses.cgc_cycle.active || GD->procedures.dirty->size > 0) &&
+       COMPARE_AND_SWAP_INT(&GD->clauses.cgc_active, false, true) )
+  { double t0 = WallTime();
+    double c0 = ThreadCPUTime(CPU_USER);
+    double gct, st;
+
+    if ( !GD->clauses.cgc_cycle.active &&
+	 !(rc=cgc_start_cycle()) )
+      goto out;
+
+    *done = cgc_clean_pending(t0, max_pause, &rc);
+
+    gct = ThreadCPUTime(CPU_USER) - c0;
+    GD->clauses.cgc_time       += gct;
+    GD->clauses.cgc_cycle.time += gct;
+    GD->clauses.cgc_slices++;
+    if ( (st=WallTime()-t0) > GD->clauses.cgc_slice_time_max )
+      GD->clauses.cgc_slice_time_max = st;
+    metric_observe(METRIC_CGC_PAUSE, st);
+
+    if ( *done && !cgc_finish_cycle() )
+      rc = false;
+
   out:
     GD->clauses.cgc_active = false;
   }
@@ -2775,6 +2869,57 @@ pl_garbage_collect_clauses(void)
   return rc;
 }
 
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+garbage_collect_clauses/0 completes a running  cycle. As that cycle can
+only reclaim clauses erased before it   started,  we run a new complete
+cycle afterwards.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+foreign_t
+pl_garbage_collect_clauses(void)
+{ GET_LD
+  bool done;
+  bool rc = true;
+
+  if ( GD->clauses.cgc_cycle.active )
+    rc = clause_gc_slice(0.0, &done);
+  if ( rc )
+    rc = clause_gc_slice(0.0, &done);
+
+  return rc;
+}
+
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Run a CGC slice limited by the   `cgc_max_pause`  flag. Called from the
+gc thread and the SIG_CLAUSE_GC handler.   If the cycle is not complete,
+schedule the next slice.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+bool
+garbageCollectClausesSlice(void)
+{ GET_LD
+  bool done;
+  bool rc = clause_gc_slice(GD->clauses.cgc_max_pause, &done);
+
+  if ( !done )
+    signalGCThread(SIG_CLAUSE_GC);
+
+  return rc;
+}
+
+
+/** '$cgc_slice'
+ *
+ * Run a single time-limited clause GC slice.  Used by the gc thread.
+ */
+
+static
+PRED_IMPL("$cgc_slice", 0, cgc_slice, 0)
+{ return garbageCollectClausesSlice();
+}
+
 #endif /*O_CLAUSEGC*/
 
 #ifdef O_DEBUG
@@ -4360,6 +4505,7 @@ BeginPredDefs(proc)
 	   PL_FA_TRANSPARENT|PL_FA_NONDETERMINISTIC|PL_FA_ISO)
   PRED_DEF("copy_predicate_clauses", 2, copy_predicate_clauses, PL_FA_TRANSPARENT)
   PRED_DEF("$cgc_params", 6, cgc_params, 0)
+  PRED_DEF("$cgc_slice", 0, cgc_slice, 0)
   PRED_DEF("$foreign_predicate_source", 2, foreign_predicate_source,
 	   PL_FA_TRANSPARENT)
 #ifdef O_ENGINES
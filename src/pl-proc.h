@@ -121,6 +121,7 @@ foreign_t	pl_check_procedure(term_t desc);
 void		checkDefinition(Definition def);
 Procedure	isStaticSystemProcedure(functor_t fd);
 foreign_t	pl_garbage_collect_clauses(void);
+bool		garbageCollectClausesSlice(void);
 bool		setDynamicDefinition(Definition def, bool isdyn);
 bool		setThreadLocalDefinition(Definition def, bool isdyn);
 bool		setAttrDefinition(Definition def, uint64_t attr, bool val);
@@ -1422,6 +1422,16 @@ loadClauseFlags(wic_state *state, Clause cl, int skip)
   }
 }
 
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+loadPredicate() decodes and compiles all clauses of a predicate eagerly.
+Deferring this to the first call (using a stub supervisor as S_VIRGIN
+does) is not possible with the current format: clauses refer to atoms,
+functors and procedures through the XR table, whose entries are defined
+on first use and referenced by sequence number afterwards.  Skipping a
+predicate thus loses the XR definitions it contains, and the table is
+discarded after loading.  Lazy loading requires a format with a global,
+up-front XR table and a per-predicate offset index.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 static bool
 loadPredicate(DECL_LD wic_state *state, int skip)
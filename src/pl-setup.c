@@ -860,7 +860,7 @@ static void
 cgc_handler(int sig)
 { (void)sig;
 
-  pl_garbage_collect_clauses();
+  garbageCollectClausesSlice();
 }
 
 
@@ -1765,6 +1765,7 @@ freePrologLocalData(PL_local_data_t *ld)
 { discardBuffer(&ld->fli._discardable_buffer);
   discardStringStack(&ld->fli.string_buffers);
   freeVarDefs(ld);
+  freeLocalClauseCache(ld);
 
 #ifdef O_GVAR
   if ( ld->gvar.nb_vars )
@@ -1820,6 +1821,7 @@ freePrologLocalData(PL_local_data_t *ld)
 
   cleanAbortHooks(ld);
   unreferenceStandardStreams(ld);
+  freeHeapCache(ld);
 }
 
 /* The following definitions aren't necessary for compiling, and in fact
@@ -56,6 +56,7 @@
 #include "pl-termhash.h"
 #include "pl-variant.h"
 #include "pl-index.h"
+#include "pl-metrics.h"
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 We provide two answer completion strategies:
@@ -286,6 +287,7 @@ new_component(void)
 
   memset(c, 0, sizeof(*c));
   c->magic = COMPONENT_MAGIC;
+  c->created = WallTime();
 
   return c;
 }
@@ -4885,6 +4887,7 @@ PRED_IMPL("$tbl_table_complete_all", 3, tbl_table_complete_all, 0)
     }
     reset_newly_created_worklists(c, WLFS_FREE_NONE);
     c->status = SCC_COMPLETED;
+    metric_observe(METRIC_TABLE_COMPLETION, WallTime()-c->created);
 
     if ( c->parent && LD->tabling.component == c )
       LD->tabling.component = c->parent;
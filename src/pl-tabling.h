@@ -86,6 +86,7 @@ typedef struct tbl_component
   worklist_set         *created_worklists;	/* Worklists created */
   worklist_set	       *delay_worklists;	/* Worklists in need for delays */
   trie		       *leader;			/* Leading variant */
+  double		created;		/* WallTime() at creation */
 } tbl_component;
 
 typedef struct tbl_status
@@ -74,6 +74,7 @@
 #include "pl-prims.h"
 #include "pl-supervisor.h"
 #include "pl-coverage.h"
+#include "pl-metrics.h"
 #include "os/pl-prologflag.h"
 #include <stdio.h>
 #include <math.h>
@@ -4749,6 +4750,7 @@ get_message(DECL_LD message_queue *queue, term_t msg,
   word key = (isvar ? 0L : getIndexOfTerm(msg));
   fid_t fid = PL_open_foreign_frame();
   uint64_t seen = 0;
+  double wait_start = 0.0;
 
   QSTAT(getmsg);
 
@@ -4836,6 +4838,8 @@ get_message(DECL_LD message_queue *queue, term_t msg,
 	  cv_signal(&queue->drain_var);
 	}
 #endif
+	if ( wait_start > 0.0 )
+	  metric_observe(METRIC_QUEUE_WAIT, WallTime()-wait_start);
 
 	PL_close_foreign_frame(fid);
 	return true;
@@ -4851,6 +4855,8 @@ get_message(DECL_LD message_queue *queue, term_t msg,
     queue->waiting++;
     queue->waiting_var += isvar;
     DEBUG(MSG_QUEUE_WAIT, Sdprintf("%d: waiting on queue\n", PL_thread_self()));
+    if ( wait_start == 0.0 )
+      wait_start = WallTime();
     rc = dispatch_cond_wait(queue, QUEUE_WAIT_READ, deadline, retry);
     switch ( rc )
     { case CV_INTR:
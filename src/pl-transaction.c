@@ -299,13 +299,51 @@ retract_clause_gen(Clause clause, gen_t generation)
     clause->generation.erased = generation;
 }
 
-#define transaction_commit(_) LDFUNC(transaction_commit, _)
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Conflict detection.  A transaction  conflicts  if   one  of  the  dynamic
+predicates it modified has been   modified  by another (transaction) commit
+after our transaction started. This  provides  \jargon{first committer
+wins} snapshot isolation: only write/write conflicts are detected.
+
+This must be called with L_GENERATION  locked. transaction_commit() sets
+the last_modified generation of the  modified predicates before releasing
+the lock, so concurrent commits cannot miss each other.  Modifications
+outside transactions are detected if they  are completed before the
+commit starts.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define transaction_conflict(_) LDFUNC(transaction_conflict, _)
+static bool
+transaction_conflict(DECL_LD)
+{ if ( LD->transaction.predicates )
+  { FOR_TABLE(LD->transaction.predicates, n, v)
+    { Definition def = val2ptr(n);
+
+      if ( def->last_modified > LD->transaction.gen_start )
+      { DEBUG(MSG_COMMIT,
+	      Sdprintf("Commit conflict on %s\n", predicateName(def)));
+	return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+#define transaction_commit(flags) LDFUNC(transaction_commit, flags)
 static int
-transaction_commit(DECL_LD)
+transaction_commit(DECL_LD int flags)
 { if ( LD->transaction.clauses )
   { gen_t gen_commit;
+    double t0;
 
     PL_LOCK(L_GENERATION);
+    t0 = WallTime();
+    if ( (flags&TR_CONFLICT_FAIL) && transaction_conflict() )
+    { PL_UNLOCK(L_GENERATION);
+      ATOMIC_INC(&GD->statistics.transactions.conflicts);
+      return false;
+    }
     gen_commit = global_generation()+1;
 
     FOR_TABLE(LD->transaction.clauses, n, v)
@@ -338,8 +376,16 @@ transaction_commit(DECL_LD)
 	retract_clause_gen(cl, gen_commit);
       }
     }
+    if ( LD->transaction.predicates )	/* see transaction_conflict() */
+    { FOR_TABLE(LD->transaction.predicates, n, v)
+      { Definition def = val2ptr(n);
+
+	def->last_modified = gen_commit;
+      }
+    }
     MEMORY_RELEASE();
     GD->_generation = gen_commit;
+    GD->statistics.transactions.commit_time += WallTime()-t0;
     PL_UNLOCK(L_GENERATION);
 
     FOR_TABLE(LD->transaction.clauses, n, v)
@@ -354,6 +400,7 @@ transaction_commit(DECL_LD)
     destroyHTablePW(LD->transaction.clauses);
     LD->transaction.clauses = NULL;
   }
+  ATOMIC_INC(&GD->statistics.transactions.committed);
 
   return true;
 }
@@ -640,9 +687,14 @@ transaction(DECL_LD term_t goal, term_t constraint, term_t lock, int flags)
       { transaction_updates(&updates);
 	rc = announce_updates(&updates);
       }
-      if ( rc )
-      { rc = ( transaction_commit_tables() &&
-	       transaction_commit() );
+      if ( rc && !transaction_commit(flags) )
+      { if ( locked ) TR_UNLOCK();
+	LD->transaction.generation = 0;	/* conflict, see transaction_conflict() */
+	transaction_discard();
+	transaction_rollback_tables();
+	rc = false;
+      } else if ( rc )
+      { rc = transaction_commit_tables();
 	if ( locked ) TR_UNLOCK();
       } else
       { if ( locked ) TR_UNLOCK();
@@ -671,6 +723,7 @@ transaction(DECL_LD term_t goal, term_t constraint, term_t lock, int flags)
 
 static const PL_option_t transaction_options[] =
 { { ATOM_bulk,		 OPT_BOOL },
+  { ATOM_conflict,	 OPT_ATOM },
   { NULL_ATOM,		 0 }
 };
 
@@ -679,12 +732,22 @@ PRED_IMPL("$transaction", 2, transaction, PL_FA_TRANSPARENT)
 { PRED_LD
   int flags = TR_TRANSACTION;
   int bulk = false;
+  atom_t conflict = ATOM_ignore;
 
   if ( !PL_scan_options(A2, 0, "transaction_option",
-			transaction_options, &bulk) )
+			transaction_options, &bulk, &conflict) )
     return false;
   if ( bulk )
     flags |= TR_BULK;
+  if ( conflict == ATOM_fail )
+  { flags |= TR_CONFLICT_FAIL;
+  } else if ( conflict != ATOM_ignore )
+  { term_t ex;
+
+    return ( (ex=PL_new_term_ref()) &&
+	     PL_put_atom(ex, conflict) &&
+	     PL_domain_error("transaction_conflict", ex) );
+  }
 
   return transaction(A1, 0, 0, flags);
 }
@@ -41,6 +41,7 @@
 #define TR_TRANSACTION		0x0001
 #define TR_SNAPSHOT		0x0002
 #define TR_BULK			0x0004
+#define TR_CONFLICT_FAIL	0x0008
 
 #define GEN_TR_ASSERT_ERASE		2
 #define GEN_TR_DISCARD_ASSERT		3
@@ -36,6 +36,7 @@
 #include "pl-variant.h"
 #include "pl-gc.h"
 #include "pl-setup.h"
+#include "pl-prims.h"
 
 
 		/********************************
@@ -529,6 +530,130 @@ PRED_IMPL("\\=@=", 2, not_variant, 0)
   return !is_variant_ptr(valTermRef(A1), valTermRef(A2));
 }
 
+		 /*******************************
+		 *	  NB_SET SUPPORT	*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+'$nb_set_probe'(+Key, +Hash, +Set, -Index)
+
+Probe the closed hash table of library(nb_set) for Key. Set is a term
+nb_set(Empty, Capacity, Size, Buckets), where  free   slots  in Buckets
+are the very term Empty. Unifies Index with 0  if a variant of Key is in
+the set and with the (1-based) index of the  first free slot otherwise.
+This is the inner loop of add_nb_set/3, which used to be written as a
+nondeterministic probe sequence in Prolog.   As  the library keeps the
+table at most half full, the loop always terminates.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+static
+PRED_IMPL("$nb_set_probe", 4, nb_set_probe, 0)
+{ PRED_LD
+  Word set = valTermRef(A3);
+  Word key = valTermRef(A1);
+  Word empty, bp;
+  Functor buckets;
+  int64_t hash, capacity;
+  size_t i;
+
+  deRef(set);
+  if ( !hasFunctor(*set, FUNCTOR_nb_set4) )
+    return PL_type_error("nb_set", A3);
+  if ( !PL_get_int64_ex(A2, &hash) )
+    return false;
+
+  empty = argTermP(*set, 0);
+  deRef(empty);
+  bp = argTermP(*set, 1);
+  deRef(bp);
+  if ( !isTaggedInt(*bp) || (capacity=valInt(*bp)) <= 0 )
+    return PL_type_error("nb_set", A3);
+  bp = argTermP(*set, 3);
+  deRef(bp);
+  if ( !isTerm(*bp) || arityTerm(*bp) != (size_t)capacity )
+    return PL_type_error("nb_set", A3);
+  buckets = valueTerm(*bp);
+
+  if ( (hash %= capacity) < 0 )		/* Prolog mod/2 */
+    hash += capacity;
+  i = (size_t)hash;
+  for(size_t n=0; n < (size_t)capacity; n++)
+  { Word p = &buckets->arguments[i];
+
+    deRef(p);
+    if ( *p == *empty )
+      return PL_unify_int64(A4, i+1);
+    if ( is_variant_ptr(key, p) )
+      return PL_unify_int64(A4, 0);
+    if ( exception_term )
+      return false;
+    if ( ++i == (size_t)capacity )
+      i = 0;
+  }
+
+  return PL_representation_error("nb_set");	/* table is full */
+}
+
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+'$ht_probe'(+Key, +Hash, +HT, -Index)
+
+Probe the open hash table of library(hashtable) for Key.  HT is a term
+ht(Load, Size, Buckets), where  Buckets  holds   Size  key/value  pairs
+and a free slot has an unbound key.  Unifies Index with the (0-based)
+index of the slot whose key is ==  to   Key  or,  if there is no such
+slot, with the index of the first free slot.  The caller distinguishes
+the two cases by checking whether the key at Index is bound.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+static
+PRED_IMPL("$ht_probe", 4, ht_probe, 0)
+{ PRED_LD
+  Word ht = valTermRef(A3);
+  Word key = valTermRef(A1);
+  Word bp;
+  Functor buckets;
+  int64_t hash, size;
+  size_t i;
+
+  deRef(ht);
+  if ( !hasFunctor(*ht, FUNCTOR_ht3) )
+    return PL_type_error("hashtable", A3);
+  if ( !PL_get_int64_ex(A2, &hash) )
+    return false;
+
+  bp = argTermP(*ht, 1);
+  deRef(bp);
+  if ( !isTaggedInt(*bp) || (size=valInt(*bp)) <= 0 )
+    return PL_type_error("hashtable", A3);
+  bp = argTermP(*ht, 2);
+  deRef(bp);
+  if ( !isTerm(*bp) || arityTerm(*bp) < 2*(size_t)size )
+    return PL_type_error("hashtable", A3);
+  buckets = valueTerm(*bp);
+
+  if ( (hash %= size) < 0 )		/* Prolog mod/2 */
+    hash += size;
+  i = (size_t)hash;
+  for(size_t n=0; n < (size_t)size; n++)
+  { Word p = &buckets->arguments[2*i];
+    cmpex_t rc;
+
+    deRef(p);
+    if ( canBind(*p) )
+      return PL_unify_int64(A4, i);
+    if ( (rc=compareStandard(key, p, true)) == CMPEX_EQUAL )
+      return PL_unify_int64(A4, i);
+    if ( rc == CMP_ERROR )
+      return false;
+    if ( ++i == (size_t)size )
+      i = 0;
+  }
+
+  return PL_representation_error("hashtable");	/* table is full */
+}
+
+
 		 /*******************************
 		 *      PUBLISH PREDICATES	*
 		 *******************************/
@@ -536,4 +661,6 @@ PRED_IMPL("\\=@=", 2, not_variant, 0)
 BeginPredDefs(variant)
   PRED_DEF("=@=", 2, variant, 0)
   PRED_DEF("\\=@=", 2, not_variant, 0)
+  PRED_DEF("$nb_set_probe", 4, nb_set_probe, 0)
+  PRED_DEF("$ht_probe", 4, ht_probe, 0)
 EndPredDefs
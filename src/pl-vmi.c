@@ -3958,6 +3958,23 @@ VMI(A_ROUNDTOWARDS_V, 0, 1, (CA1_VAR))
 END_VMI
 
 
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AR_FLOAT_FAST() handles the common case where  both arguments are floats
+and the result is a normal float or  zero, i.e., check_float() has nothing
+to do. The result replaces the left  argument   on  the stack. All other
+cases are handled by the generic function.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#define AR_FLOAT_FAST(op) \
+  if ( argv[0].type == V_FLOAT && argv[1].type == V_FLOAT ) \
+  { double f = argv[0].value.f op argv[1].value.f; \
+    if ( isnormal(f) || f == 0.0 ) \
+    { argv[0].value.f = f; \
+      popArgvArithStack(1); \
+      NEXT_INSTRUCTION; \
+    } \
+  }
+
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 A_ADD: Shorthand for A_FUNC2 pl_ar_add()
 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -3967,6 +3984,7 @@ VMI(A_ADD, 0, 0, ())
   int rc;
   number r;
 
+  AR_FLOAT_FAST(+);
   SAVE_REGISTERS(QID);
   rc = pl_ar_add(argv+1, argv, &r);
   LOAD_REGISTERS(QID);
@@ -3990,6 +4008,7 @@ VMI(A_MUL, 0, 0, ())
   int rc;
   number r;
 
+  AR_FLOAT_FAST(*);
   SAVE_REGISTERS(QID);
   rc = ar_mul(argv+1, argv, &r);
   LOAD_REGISTERS(QID);
@@ -69,6 +69,7 @@
 #include "pl-cont.h"
 #include "pl-coverage.h"
 #include <fenv.h>
+#include <math.h>
 #ifdef _MSC_VER
 #pragma warning(disable: 4102)		/* unreferenced labels */
 #endif
@@ -1255,11 +1255,16 @@ format_float(char *buf, size_t size, double f, int N, char E)
   int decpt, sign;
   size_t sz;
   char *limit = &buf[size];
+  char digits[16];
+  bool fast;
 
   if ( (sz=format_special_float(buf, size, f)) )
     return sz;
 
-  s = dtoa(f, 0, 30, &decpt, &sign, &end);
+  if ( (fast=fast_dtoa(f, digits, &decpt, &sign, &end)) )
+    s = digits;
+  else
+    s = dtoa(f, 0, 30, &decpt, &sign, &end);
   DEBUG(MSG_WRITE_FLOAT,
 	Sdprintf("dtoa(): decpt=%d, sign=%d, len = %d, '%s'\n",
 		 decpt, sign, end-s, s));
@@ -1332,7 +1337,8 @@ format_float(char *buf, size_t size, double f, int N, char E)
 #undef OUTS
 #undef OUT
 
-  freedtoa(s);
+  if ( !fast )
+    freedtoa(s);
 
   if ( o < limit )
     *o = 0;
@@ -835,6 +835,203 @@ IOFUNCTIONS Szipfunctions_repositioning =
   NULL						/* seek64 */
 };
 
+
+		 /*******************************
+		 *	   READ AHEAD		*
+		 *******************************/
+
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Loading the saved state is a  strictly   sequential  process:  the QLF
+decoder builds its XR table  incrementally   and  runs  directives in
+order, so clauses cannot be decoded  concurrently.   We  can  however
+inflate the entry in parallel with decoding it.  If RC_READAHEAD is
+passed to SopenZIP() for a compressed entry  and the machine has more
+than one CPU, a worker thread inflates   the entry into two alternating
+buffers while the stream consumes the other one.  As the gain has not
+been measured on a range of machines, the  state is only opened this
+way if the user sets SWIPL_STATE_READAHEAD.
+- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#ifdef O_PLMT
+#define ZIP_READAHEAD_BUFSIZE (256*1024)
+
+typedef struct zip_ra_buffer
+{ ssize_t	  len;				/* bytes; 0: EOF, -1: error */
+  int		  errno_;			/* errno if len == -1 */
+  bool		  filled;			/* data is available */
+  char		  data[ZIP_READAHEAD_BUFSIZE];
+} zip_ra_buffer;
+
+typedef struct zip_readahead
+{ zipper	 *zipper;			/* zipper we read from */
+  pthread_t	  tid;				/* inflating thread */
+  pthread_mutex_t mutex;
+  pthread_cond_t  cond;
+  int64_t	  size;				/* uncompressed size */
+  int		  cur;				/* buffer being consumed */
+  size_t	  pos;				/* read position in buf[cur] */
+  bool		  stop;				/* stream is being closed */
+  zip_ra_buffer	  buf[2];
+} zip_readahead;
+
+static void *
+zip_readahead_worker(void *closure)
+{ zip_readahead *ra = closure;
+
+  for(int i=0;;i ^= 1)
+  { ssize_t n;
+    bool stop;
+
+    pthread_mutex_lock(&ra->mutex);
+    while( ra->buf[i].filled && !ra->stop )
+      pthread_cond_wait(&ra->cond, &ra->mutex);
+    stop = ra->stop;
+    pthread_mutex_unlock(&ra->mutex);
+    if ( stop )
+      break;
+
+    errno = 0;
+    n = unzReadCurrentFile(ra->zipper->reader,
+			   ra->buf[i].data, ZIP_READAHEAD_BUFSIZE);
+
+    pthread_mutex_lock(&ra->mutex);
+    ra->buf[i].len    = n < 0 ? -1 : n;
+    ra->buf[i].errno_ = errno ? errno : EIO;
+    ra->buf[i].filled = true;
+    pthread_cond_broadcast(&ra->cond);
+    pthread_mutex_unlock(&ra->mutex);
+    if ( n <= 0 )
+      break;
+  }
+
+  return NULL;
+}
+
+static ssize_t
+Sread_zip_readahead(void *handle, char *buf, size_t size)
+{ zip_readahead *ra = handle;
+  zip_ra_buffer *b = &ra->buf[ra->cur];
+  ssize_t n;
+
+  pthread_mutex_lock(&ra->mutex);
+  while( !b->filled )
+    pthread_cond_wait(&ra->cond, &ra->mutex);
+  pthread_mutex_unlock(&ra->mutex);
+
+  if ( b->len <= 0 )			/* EOF or error: keep reporting it */
+  { if ( b->len < 0 )
+      errno = b->errno_;
+    return b->len;
+  }
+
+  n = b->len - ra->pos;
+  if ( (size_t)n > size )
+    n = size;
+  memcpy(buf, b->data+ra->pos, n);
+  ra->pos += n;
+
+  if ( ra->pos == (size_t)b->len )
+  { pthread_mutex_lock(&ra->mutex);
+    b->filled = false;
+    ra->cur ^= 1;
+    ra->pos = 0;
+    pthread_cond_broadcast(&ra->cond);
+    pthread_mutex_unlock(&ra->mutex);
+  }
+
+  return n;
+}
+
+static int
+Sclose_zip_readahead(void *handle)
+{ zip_readahead *ra = handle;
+  zipper *z = ra->zipper;
+
+  pthread_mutex_lock(&ra->mutex);
+  ra->stop = true;
+  pthread_cond_broadcast(&ra->cond);
+  pthread_mutex_unlock(&ra->mutex);
+  pthread_join(ra->tid, NULL);
+  pthread_cond_destroy(&ra->cond);
+  pthread_mutex_destroy(&ra->mutex);
+  free(ra);
+
+  return Sclose_zip_entry(z);
+}
+
+static int
+Scontrol_zip_readahead(void *handle, int action, void *arg)
+{ zip_readahead *ra = handle;
+
+  switch(action)
+  { case SIO_GETSIZE:
+    { int64_t *rval = arg;
+      *rval = ra->size;
+      return 0;
+    }
+    case SIO_FLUSHOUTPUT:
+    case SIO_SETENCODING:
+      return 0;
+    default:
+      return -1;
+  }
+}
+
+static IOFUNCTIONS Szipreadaheadfunctions =
+{ Sread_zip_readahead,
+  NULL,
+  NULL,
+  Sclose_zip_readahead,
+  Scontrol_zip_readahead,
+  NULL						/* seek64 */
+};
+
+/* Open a read-ahead stream on the current entry of z.  Returns NULL
+   if read-ahead is not worthwhile or cannot be started, in which case
+   the caller uses a normal entry stream.
+*/
+
+static IOSTREAM *
+SopenZIPReadAhead(zipper *z)
+{ unz_file_info64 info;
+  zip_readahead *ra;
+  IOSTREAM *s;
+
+  if ( CpuCount() < 2 ||
+       unzGetCurrentFileInfo64(z->reader, &info,
+			       NULL, 0, NULL, 0, NULL, 0) != UNZ_OK ||
+       info.compression_method == 0 ||
+       !(ra = malloc(sizeof(*ra))) )
+    return NULL;
+
+  memset(ra, 0, offsetof(zip_readahead, buf));
+  ra->buf[0].filled = ra->buf[1].filled = false;	/* skip clearing data */
+  ra->zipper = z;
+  ra->size   = info.uncompressed_size;
+  pthread_mutex_init(&ra->mutex, NULL);
+  pthread_cond_init(&ra->cond, NULL);
+
+  if ( pthread_create(&ra->tid, NULL, zip_readahead_worker, ra) != 0 )
+    goto failed;
+  if ( !(s=Snew(ra, SIO_INPUT, &Szipreadaheadfunctions)) )
+  { pthread_mutex_lock(&ra->mutex);
+    ra->stop = true;
+    pthread_cond_broadcast(&ra->cond);
+    pthread_mutex_unlock(&ra->mutex);
+    pthread_join(ra->tid, NULL);
+    goto failed;
+  }
+
+  return s;
+
+failed:
+  pthread_cond_destroy(&ra->cond);
+  pthread_mutex_destroy(&ra->mutex);
+  free(ra);
+  return NULL;
+}
+#endif /*O_PLMT*/
+
 		 /*******************************
 		 *	  HANDLE ENTRIES	*
 		 *******************************/
@@ -1428,6 +1625,11 @@ SopenZIP(zipper *z, const char *name, int flags)
 	 zacquire(z, ZIP_READ_ENTRY, NULL, "open_current") &&
 	 unzOpenCurrentFile(z->reader) == UNZ_OK )
     { set(z, ZIP_RELEASE_ON_CLOSE);
+#ifdef O_PLMT
+      IOSTREAM *s;
+      if ( (flags&RC_READAHEAD) && (s=SopenZIPReadAhead(z)) )
+	return s;
+#endif
       return Snew(z, SIO_INPUT, &Szipfunctions);
     }
   } else
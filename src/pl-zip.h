@@ -84,6 +84,7 @@ typedef struct zipper
 #define RC_WRONLY	0x02
 #define RC_CREATE	0x04
 #define RC_TRUNC	0x08
+#define RC_READAHEAD	0x10			/* inflate in a background thread */
 #define RC_RDWR		(RC_RDONLY|RC_WRONLY)
 
 extern int rc_errno;
@@ -689,6 +689,12 @@ test(multiplication) :-
 test(multiplication) :-
 	X is -4294967296 * 4294967296 - -9223372036854775807,
 	test_minint_promotion(X).
+test(multiplication, X == 85070591730234615865843651857942052864) :-
+	X is -9223372036854775808 * -9223372036854775808.
+test(multiplication, X == -85070591730234615856620279821087277056) :-
+	X is -9223372036854775808 * 9223372036854775807.
+test(subtraction, X == -18446744073709551615) :-
+	X is -9223372036854775808 - 9223372036854775807.
 :- endif.
 
 :- end_tests(minint_promotion).
@@ -955,6 +961,16 @@ test(float_rval) :-
 :- set_prolog_flag(optimise, true).
 test(float_rval) :-
 	6.5 is max(6.5,3).
+test(float_add, X == 0.30000000000000004) :-
+	A = 0.1, B = 0.2,
+	X is A+B.
+test(float_mul, X == -0.0) :-
+	A = -0.0,
+	X is A*2.0.
+test(float_mul, error(evaluation_error(float_overflow))) :-
+	A = 1.0e308,
+	X is A*10.0,
+	writeln(X).
 
 :- end_tests(arith_misc).
 
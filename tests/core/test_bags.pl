@@ -86,5 +86,8 @@ test(agc, Xs == [ aaaa100001,aaaa100002,aaaa100003,aaaa100004,
 gen_atom(A) :-
 	between(1, infinite, X),
 	atom_concat(aaaa, X, A).
+test(mixed, Xs =@= [1,a,f(_),_,"s",1.5,[],-5,100000000000000000000]) :-
+	findall(X, member(X, [1,a,f(_),_,"s",1.5,[],-5,100000000000000000000]),
+		Xs).
 
 :- end_tests(bags).
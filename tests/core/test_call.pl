@@ -77,6 +77,20 @@ link_clause(N, V0, V, (succ(V0, V1), G)) :-
         N2 is N - 1,
         link_clause(N2, V1, V, G).
 
+test(cached, L == [a-1, "s"-2.5, f(x)-3, 10000000000000000000000-[]]) :-
+	findall(X-Y,
+		( member(X-Y0, [a-1, "s"-2.5, f(x)-3, 10000000000000000000000-[]]),
+		  G = (atomic(Y0) -> Y = Y0 ; Y = Y0),
+		  call(G)
+		), L).
+test(cached, L == [1,3]) :-
+	findall(X, (member(X, [1,2,3]), G = (\+ X == 2), G), L).
+test(cached, Hits > 0) :-
+	statistics(metacall_cache_hits, H0),
+	forall(between(1, 10, I), call((integer(I), I > 0))),
+	statistics(metacall_cache_hits, H1),
+	Hits is H1-H0.
+
 :- end_tests(call1).
 
 :- begin_tests(apply).
@@ -43,7 +43,8 @@
 test_copy_term :-
     run_tests([ copy_term,
 		copy_term_4,
-                copy_term_nat_4
+                copy_term_nat_4,
+		duplicate_term
 	      ]).
 
 /** <module> Test unit for copy_term/2 and friends
@@ -105,6 +106,29 @@ test(attvar,  CQ == q(CX,Y)) :-
 
 :- end_tests(copy_term_nat_4).
 
+		 /*******************************
+		 *        DUPLICATE_TERM	*
+		 *******************************/
+
+:- begin_tests(duplicate_term).
+
+test(large) :-				% requires growing the global stack
+    numlist(1, 500_000, L),
+    Term = t(L, L, X, X),
+    duplicate_term(Term, Copy),
+    assertion(Term =@= Copy),
+    Copy = t(L1, L2, _, _),
+    assertion(\+ same_term(L, L1)),
+    assertion(same_term(L1, L2)).
+test(attvar) :-
+    put_attr(X, test, 1),
+    duplicate_term(t(X,X), t(A,B)),
+    assertion(A == B),
+    assertion(A \== X),
+    assertion(get_attr(A, test, 1)).
+
+:- end_tests(duplicate_term).
+
 
 
 test_copy(Vs, Term, Shared) :-
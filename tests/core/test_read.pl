@@ -74,6 +74,18 @@ test(position,
                   comments(Comments)
                 ]).
 
+test(long_tokens, Pos == term_position(0, 20009, 0, 1,
+				       [2-5002, 5003-10005, 10006-20008])) :-
+	length(L, 5000), maplist(=(0'a), L),
+	atom_codes(A, L),
+	format(string(S), 'f(~w,\'~w\',"~w~w")', [A,A,A,A]),
+	term_string(T, S, [subterm_positions(Pos0)]),
+	T = f(A1,A2,S2),
+	A1 == A, A2 == A,
+	string_length(S2, 10000),
+	Pos0 = term_position(F,T0,FF,FT,[P1,P2,string_position(S0,SE)]),
+	Pos = term_position(F,T0,FF,FT,[P1,P2,S0-SE]).
+
 test(valid_position_var) :-
     term_position_check("Var", _Var, 0-3).
 
@@ -143,4 +143,38 @@ test(dict, error(existence_error(key,a,a{b:2}))) :-
 test(dict, error(type_error(dict,a(1)))) :-
 	sort(a, @<, [a(1), a(2)], _).
 
+% specialised integer and atom sorting must give the same result as
+% the generic sort.
+test(special, S1 == S2) :-
+	findall(K-I, (between(1, 1000, I), K is (I*7919) mod 300 - 150), Pairs),
+	sort(1, @>=, Pairs, S1),
+	findall(f(K)-I, member(K-I, Pairs), WPairs),
+	sort(1, @>=, WPairs, WS),
+	findall(K-I, member(f(K)-I, WS), S2).
+test(special, S1 == S2) :-
+	findall(A, (between(1, 1000, I), K is (I*7919) mod 300,
+		    format(atom(A), 'k~d', [K])), Atoms),
+	sort(0, @<, Atoms, S1),
+	findall(f(A), member(A, Atoms), WAtoms),
+	sort(0, @<, WAtoms, WS),
+	findall(A, member(f(A), WS), S2).
+
+% parallel sort must produce the same result as the sequential one
+test(parallel, S1 == S2) :-
+	findall(K-I, (between(1, 200000, I), K is (I*7919) mod 1000), Pairs),
+	sort_with_cpus(1, 1, @>=, Pairs, S1),
+	sort_with_cpus(4, 1, @>=, Pairs, S2).
+test(parallel, S1 == S2) :-
+	findall(A, (between(1, 200000, I), K is (I*7919) mod 5000,
+		    atom_number(A, K)), Atoms),
+	sort_with_cpus(1, 0, @<, Atoms, S1),
+	sort_with_cpus(4, 0, @<, Atoms, S2).
+
+sort_with_cpus(N, Key, Order, List, Sorted) :-
+	current_prolog_flag(cpu_count, Old),
+	setup_call_cleanup(
+	    set_prolog_flag(cpu_count, N),
+	    sort(Key, Order, List, Sorted),
+	    set_prolog_flag(cpu_count, Old)).
+
 :- end_tests(sort4).
@@ -236,6 +236,26 @@ test(nan) :-
 	atom_number(F, Float),
 	abs(Float) >= 1,
 	abs(Float) < 2.
+test(shortest, L == ['0.1','1.5','-2.25','100.0','1.0e+10','1.0e-07',
+		     '123456.789','0.30000000000000004']) :-
+	X is 0.1+0.2,
+	maplist([F,A]>>format(atom(A), '~w', [F]),
+		[0.1, 1.5, -2.25, 100.0, 1e10, 1e-7, 123456.789, X], L).
+test(round_trip) :-
+	forall(between(1, 1000, I),
+	       ( F is I/7.0 + I*1.0e-3,
+		 format(atom(A), '~w', [F]),
+		 atom_number(A, F2),
+		 F2 =:= F )).
+test(round_trip_rounding, [A-F2 == '0.30000000000000004'-F]) :-
+	current_prolog_flag(float_rounding, Old),
+	setup_call_cleanup(
+	    set_prolog_flag(float_rounding, to_positive),
+	    ( F is 0.1*3,
+	      format(atom(A), '~w', [F])
+	    ),
+	    set_prolog_flag(float_rounding, Old)),
+	atom_number(A, F2).
 
 :- end_tests(write_float).
 
@@ -40,8 +40,9 @@
 
 /** <module> Test clause garbage collection
 
-This module tests clause gc. The current   test is about the interaction
-between predicate marking and (local) stack shifts.
+This module tests clause gc. The  first   test  is about the interaction
+between predicate marking and (local) stack shifts. The second tests CGC
+using time limited slices (see the flag `cgc_max_pause`).
 */
 
 test_cgc :-
@@ -96,6 +97,57 @@ lshift(S0) :-
 	lshift(S0).
 lshift(_).
 
+:- dynamic churn/2.
+
+sliced_cgc(Preds, Steps) :-
+	current_prolog_flag(cgc_max_pause, Old),
+	setup_call_cleanup(
+	    set_prolog_flag(cgc_max_pause, 1.0e-6),
+	    sliced_cgc_(Preds, Steps),
+	    set_prolog_flag(cgc_max_pause, Old)).
+
+sliced_cgc_(Preds, Steps) :-
+	garbage_collect_clauses,
+	statistics(cgc_slices, S0),
+	statistics(cgc, C0),
+	forall(between(1, Preds, I),
+	       ( churn_head(I, H),
+		 assertz(H), retract(H)
+	       )),
+	forall(between(1, Steps, I),
+	       ( K is I mod 100,
+		 (   retract(churn(K, _)) -> true ; true ),
+		 assertz(churn(K, I))
+	       )),
+	complete_cgc_cycle(C0, 100_000),
+	statistics(cgc_slices, S1),
+	statistics(cgc, C1),
+	assertion(S1-S0 > C1-C0),	% some cycle needed multiple slices
+	garbage_collect_clauses,
+	aggregate_all(count, churn(_,_), Count),
+	assertion(Count == 100).
+
+%	complete_cgc_cycle(+Cycles0, +MaxSlices)
+%
+%	Run clause GC slices until at least one cycle has completed
+%	since statistics(cgc, Cycles0).
+
+complete_cgc_cycle(C0, Max) :-
+	statistics(cgc, C),
+	(   C > C0
+	->  true
+	;   Max > 0
+	->  '$cgc_slice',
+	    Max1 is Max-1,
+	    complete_cgc_cycle(C0, Max1)
+	;   true
+	).
+
+churn_head(I, H) :-
+	atom_concat(test_cgc_churn_, I, Name),
+	H =.. [Name, I],
+	dynamic(Name/1).
+
 
 :- begin_tests(cgc, [ sto(rational_trees),
 		      condition(current_prolog_flag(threads, true))
@@ -103,5 +155,7 @@ lshift(_).
 
 test(shift_cgc) :-
 	shift_cgc(4, 4).
+test(sliced_cgc) :-
+	sliced_cgc(1000, 100_000).
 
 :- end_tests(cgc).
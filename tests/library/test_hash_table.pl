@@ -82,6 +82,12 @@ test(wc, Pairs == [aap-2, noot-1]) :-
     update_word_count(HT, noot),
     update_word_count(HT, aap),
     ht_pairs(HT, Pairs).
+test(variant, Size-V == 2-a) :-
+    ht_new(HT),
+    ht_put(HT, f(X), a),
+    ht_put(HT, f(_), b),
+    ht_get(HT, f(X), V),
+    ht_size(HT, Size).
 
 rfill(N, Max, FD, HT, Assoc) :-
     ht_new(HT),
@@ -49,5 +49,32 @@ test_lists :-
 % must be deterministic.
 test(reverse, L == [b,a]) :-
     reverse(L, [a,b]).
+test(sum_list, S == 6) :-
+    sum_list([1,2,3], S).
+test(sum_list, S == 3.0) :-
+    sum_list([1,2.0], S).
+test(sum_list, S == 0.6000000000000001) :-
+    sum_list([0.1,0.2,0.3], S).
+test(sum_list, S == 2305843009213693950) :-
+    sum_list([1152921504606846975,1152921504606846975], S).
+test(sum_list, error(evaluation_error(float_overflow))) :-
+    sum_list([1.0e308,1.0e308], _).
+test(max_list, M == 4) :-
+    max_list([3,1,4], M).
+test(max_list, M == 0.0) :-
+    max_list([-0.0,0.0], M).
+test(min_list, M == -0.0) :-
+    min_list([0.0,-0.0], M).
+test(max_list, fail) :-
+    max_list([], _).
+test(numlist, L == [-2,-1,0,1]) :-
+    numlist(-2, 1, L).
+test(numlist, fail) :-
+    numlist(2, 1, _).
+test(numlist, fail) :-
+    numlist(1, 1_000_000_000_000, [1,2]).
+test(numlist, L == [1,2,3]) :-
+    L = [_,_,_],
+    numlist(1, 3, L).
 
 :- end_tests(lists).
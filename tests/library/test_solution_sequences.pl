@@ -55,6 +55,12 @@ data(2, b, n0).
 
 test(distinct, all(A-B-C == [1-a-a1,2-a-n1])) :-
 	distinct(A, data(A,B,C)).
+test(distinct_variant, all(X =@= [f(_),g(_,_),g(Y,Y),1,a])) :-
+	distinct(X, member(X, [f(A),f(B),g(A,B),g(A,A),g(B,B),1,1,a,f(_)])).
+test(distinct_many, Count == 1000) :-
+	aggregate_all(count,
+		      distinct(X, (between(1, 5000, I), K is I mod 1000, X = f(K))),
+		      Count).
 
 test(limit, all(X == [1,2,3])) :-
 	limit(3, between(1, 10, X)).
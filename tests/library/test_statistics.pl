@@ -0,0 +1,84 @@
+/*  Part of SWI-Prolog
+
+    Author:        agent
+    E-mail:        agent@local
+    WWW:           http://www.swi-prolog.org
+    Copyright (c)  2026, agent
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in
+       the documentation and/or other materials provided with the
+       distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+:- module(test_statistics,
+	  [ test_statistics/0
+	  ]).
+
+
+:- use_module(library(plunit)).
+:- use_module(library(statistics)).
+:- use_module(library(lists)).
+
+test_statistics :-
+	run_tests([ latency_metrics
+		  ]).
+
+:- begin_tests(latency_metrics).
+
+test(keys, Keys == [agc_pause, cgc_pause, gc_pause, index_build,
+		    queue_wait, table_completion]) :-
+	latency_metrics(M),
+	dict_keys(M, Keys).
+test(gc_pause, true(C1 > C0)) :-
+	gc_pause_count(C0),
+	garbage_collect,
+	gc_pause_count(C1).
+test(buckets, true(Sum >= Count)) :-
+	garbage_collect,
+	latency_metrics(M),
+	get_dict(gc_pause, M, H),
+	get_dict(count, H, Count),
+	get_dict(buckets, H, Buckets),
+	pairs_values(Buckets, Counts),
+	sum_list(Counts, Sum).
+test(buckets, true(\+ memberchk(_-0, Buckets))) :-
+	garbage_collect,
+	latency_metrics(M),
+	get_dict(gc_pause, M, H),
+	get_dict(buckets, H, Buckets).
+test(text, true(sub_atom(Text, _, _, _,
+			 'swipl_gc_pause_seconds_bucket{le="+Inf"}'))) :-
+	with_output_to(atom(Text), print_latency_metrics(current_output)).
+
+gc_pause_count(Count) :-
+	latency_metrics(M),
+	get_dict(gc_pause, M, H),
+	get_dict(count, H, Count).
+
+dict_keys(Dict, Keys) :-
+	dict_pairs(Dict, _, Pairs),
+	pairs_keys(Pairs, Keys).
+
+:- end_tests(latency_metrics).
@@ -73,6 +73,59 @@ test(first, true(X==1)) :-
 test(first, true(X==1)) :-
 	first_solution(X, [(repeat,fail), X=1], []).
 
+test(findall, Bag == Expected) :-
+	findall(I-X, (ct_fact(I, X), X > 2), Expected),
+	concurrent_findall(I-X, (ct_fact(I, X), X > 2), Bag, [threads(4)]).
+test(findall, Bag == [1,2]) :-
+	concurrent_findall(X, ct_cut(X), Bag, [threads(4)]).
+test(findall, throws(x)) :-
+	concurrent_findall(X, (ct_fact(X, _), X > 90, throw(x)), _,
+			   [threads(4)]).
+test(findall, Bag == Expected) :-
+	findall(Y, ct_path(1, Y), Expected),
+	concurrent_findall(Y, ct_path(1, Y), Bag, [threads(2)]).
+test(findall, Bag == [one]) :-
+	concurrent_findall(Y, ct_ssu(1, Y), Bag, [threads(2)]).
+test(aggregate, Count == 102) :-
+	concurrent_aggregate_all(count, ct_fact(_,_), Count, [threads(4)]).
+test(aggregate, Sum == 305) :-
+	concurrent_aggregate_all(sum(X), ct_fact(_,X), Sum, [threads(4)]).
+test(aggregate, Max == 94) :-
+	concurrent_aggregate_all(max(I), ct_fact(I,3), Max, [threads(4)]).
+test(aggregate, fail) :-
+	concurrent_aggregate_all(max(I), ct_fact(I,7), _, [threads(4)]).
+test(aggregate, Set == [0,1,2,3,4,5,6]) :-
+	concurrent_aggregate_all(set(X), ct_fact(_,X), Set, [threads(4)]).
+
+ct_fact(I, X) :-
+	between(1, 100, I),
+	X is I mod 7.
+ct_fact(I, X) :-
+	ct_data(I, X).
+
+:- dynamic ct_data/2.
+ct_data(1, 3).
+ct_data(2, 5).
+
+ct_cut(1).
+ct_cut(2) :- !.
+ct_cut(3).
+
+:- table ct_path/2.
+
+ct_path(X, Y) :-
+	ct_path(X, Z),
+	ct_edge(Z, Y).
+ct_path(X, Y) :-
+	ct_edge(X, Y).
+
+ct_edge(1, 2).
+ct_edge(2, 3).
+ct_edge(3, 1).
+
+ct_ssu(1, Y) => Y = one.
+ct_ssu(_, Y) => Y = other.
+
 :- end_tests(thread).
 
 :- endif.
@@ -173,6 +173,25 @@ test(isolate_retract2b, [cleanup(cleanup)]) :-
                        in(x, ?p),
                        end(x)
                      ]).
+test(conflict, [cleanup(cleanup), X == [2]]) :-
+    \+ transaction(( concurrent_assert(p(2)),
+                     assertz(p(1))
+                   ), [conflict(fail)]),
+    findall(X0, p(X0), X).
+test(no_conflict, [cleanup(cleanup), true(p)]) :-
+    transaction(( concurrent_assert(p(2)),
+                  assertz(p)
+                ), [conflict(fail)]).
+test(conflict_ignore, [cleanup(cleanup), X == [2,1]]) :-
+    transaction(( concurrent_assert(p(2)),
+                  assertz(p(1))
+                ), [conflict(ignore)]),
+    findall(X0, p(X0), X).
+
+concurrent_assert(Term) :-
+    thread_create(assertz(Term), Id, []),
+    thread_join(Id, Status),
+    assertion(Status == true).
 
 :- end_tests(thread_transaction).
 